@@ -0,0 +1,87 @@
+// Jakub Staroń, 2016
+#include <celero/Celero.h>
+
+#include "iterators.h"
+#include "text_algorithms/aho_corasick.h"
+
+CELERO_MAIN
+
+using namespace lib;
+
+constexpr size_t samples = 3;
+constexpr size_t iterations = 1;
+
+constexpr size_t kTextSize = 100 * 1000 * 1000;
+
+/**
+ * Experiment value is number of patterns, they have from 4 to 11 letters
+ * and are taken from random text of 100 MB over 26 letters alphabet.
+ */
+class PatternsFixture : public celero::TestFixture
+{
+public:
+  std::vector<std::pair<int64_t, uint64_t>> getExperimentValues() const override
+  {
+    return {
+        {100, 0},
+        {10 * 1000, 0}
+    };
+  }
+
+  void setUp(int64_t experimentValue) override
+  {
+    if (text.empty()) {
+      text.resize(kTextSize);
+      for (auto& c: text)
+        c = char('a' + Random32() % 26);
+    }
+    patterns.clear();
+    for (auto i: range<int64_t>(0, experimentValue)) {
+      const size_t length = 4 + Random32() % 8;
+      patterns.push_back(text.substr(Random32() % (text.size() - length), length));
+    }
+    dense.reset(new AhoCorasick(patterns.begin(), patterns.end()));
+    sparse.reset(new AhoCorasick(patterns.begin(), patterns.end(), 0));
+  }
+
+  std::string text;
+  std::vector<std::string> patterns;
+  std::unique_ptr<AhoCorasick> dense;
+  std::unique_ptr<AhoCorasick> sparse;
+};
+
+BASELINE_F(Count, Sparse, PatternsFixture, samples, iterations)
+{
+  celero::DoNotOptimizeAway(sparse->count(text.begin(), text.end()));
+}
+
+BENCHMARK_F(Count, Dense, PatternsFixture, samples, iterations)
+{
+  celero::DoNotOptimizeAway(dense->count(text.begin(), text.end()));
+}
+
+BASELINE_F(Find, Sparse, PatternsFixture, samples, iterations)
+{
+  uint64 sum = 0;
+  sparse->find(text.begin(), text.end(), [&sum](uint32, uint64 offset) { sum += offset; });
+  celero::DoNotOptimizeAway(sum);
+}
+
+BENCHMARK_F(Find, Dense, PatternsFixture, samples, iterations)
+{
+  uint64 sum = 0;
+  dense->find(text.begin(), text.end(), [&sum](uint32, uint64 offset) { sum += offset; });
+  celero::DoNotOptimizeAway(sum);
+}
+
+BASELINE_F(Construction, Sparse, PatternsFixture, samples, iterations)
+{
+  AhoCorasick automaton(patterns.begin(), patterns.end(), 0);
+  celero::DoNotOptimizeAway(automaton.size());
+}
+
+BENCHMARK_F(Construction, Dense, PatternsFixture, samples, iterations)
+{
+  AhoCorasick automaton(patterns.begin(), patterns.end());
+  celero::DoNotOptimizeAway(automaton.size());
+}
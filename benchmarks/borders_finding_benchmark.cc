@@ -54,3 +54,39 @@ BENCHMARK_F(Borders, Hasher, TextFixture, samples, iterations)
   }
   celero::DoNotOptimizeAway(longest);
 }
+
+BENCHMARK_F(Borders, Mersenne61Hasher, TextFixture, samples, iterations)
+{
+  BasicHasher<hash::mersenne61> hasher(text.begin(), text.end());
+  uint32 longest = 0;
+  for (auto i: range<uint32>(1, text.size())) {
+    if (hasher.getHash(0, i) == hasher.getHash(text.size() - i, i)) {
+      longest = i;
+    }
+  }
+  celero::DoNotOptimizeAway(longest);
+}
+
+BENCHMARK_F(Borders, Mersenne61InverseFree, TextFixture, samples, iterations)
+{
+  BasicHasher<hash::mersenne61, hash::inverse_free> hasher(text.begin(), text.end());
+  uint32 longest = 0;
+  for (auto i: range<uint32>(1, text.size())) {
+    if (hasher.getHash(0, i) == hasher.getHash(text.size() - i, i)) {
+      longest = i;
+    }
+  }
+  celero::DoNotOptimizeAway(longest);
+}
+
+BENCHMARK_F(Borders, Mersenne61Equal, TextFixture, samples, iterations)
+{
+  BasicHasher<hash::mersenne61, hash::inverse_free> hasher(text.begin(), text.end());
+  uint32 longest = 0;
+  for (auto i: range<uint32>(1, text.size())) {
+    if (hasher.equal(0, text.size() - i, i)) {
+      longest = i;
+    }
+  }
+  celero::DoNotOptimizeAway(longest);
+}
@@ -0,0 +1,111 @@
+// Jakub Staroń, 2016
+#include <celero/Celero.h>
+
+#include "io.h"
+#include "iterators.h"
+#include "text_algorithms/fm_index.h"
+#include "text_algorithms/knuth_morris_pratt.h"
+
+CELERO_MAIN
+
+using namespace lib;
+
+constexpr size_t samples = 1;
+constexpr size_t iterations = 1;
+
+constexpr uint32 kAlphabetSize = 4;
+constexpr uint32 kPatterns = 100;
+constexpr uint32 kPatternLength = 16;
+
+/**
+ * Random text over 4 letters alphabet and kPatterns patterns, half of them
+ * taken from text. Text and its index are shared between benchmarks,
+ * size of index is printed when it's built.
+ */
+class TextFixture : public celero::TestFixture
+{
+public:
+  std::vector<std::pair<int64_t, uint64_t>> getExperimentValues() const override
+  {
+    return {
+        {1000 * 1000, 0},
+        {10 * 1000 * 1000, 0}
+    };
+  }
+
+  void setUp(int64_t experimentValue) override
+  {
+    if (text.size() == size_t(experimentValue))
+      return;
+    text.resize(experimentValue);
+    for (auto& c: text)
+      c = char('a' + Random32() % kAlphabetSize);
+    patterns.clear();
+    for (auto i: range<uint32>(0, kPatterns)) {
+      if (i % 2 == 0) {
+        patterns.push_back(text.substr(Random32() % (text.size() - kPatternLength), kPatternLength));
+      }
+      else {
+        patterns.emplace_back();
+        for (auto j: range<uint32>(0, kPatternLength))
+          patterns.back() += char('a' + (Random32() + j) % kAlphabetSize);
+      }
+    }
+    index.reset(new FMIndex(text));
+    print("FMIndex of %0 letters occupies %1 bytes.", text.size(), index->bytes());
+  }
+
+  static std::string text;
+  static std::vector<std::string> patterns;
+  static std::unique_ptr<FMIndex> index;
+};
+
+std::string TextFixture::text;
+std::vector<std::string> TextFixture::patterns;
+std::unique_ptr<FMIndex> TextFixture::index;
+
+BASELINE_F(Count, Matcher, TextFixture, samples, iterations)
+{
+  uint64 count = 0;
+  for (const auto& pattern: patterns) {
+    KnuthMorrisPrattMatcher<char> matcher(pattern.begin(), pattern.end());
+    matcher.feed(text.begin(), text.end(), [&count](uint64) { count++; });
+  }
+  celero::DoNotOptimizeAway(count);
+}
+
+BENCHMARK_F(Count, Automaton, TextFixture, samples, iterations)
+{
+  uint64 count = 0;
+  for (const auto& pattern: patterns) {
+    KnuthMorrisPrattAutomaton automaton(pattern.begin(), pattern.end(), 'a', kAlphabetSize);
+    automaton.feed(text.begin(), text.end(), [&count](uint64) { count++; });
+  }
+  celero::DoNotOptimizeAway(count);
+}
+
+BENCHMARK_F(Count, FMIndex, TextFixture, samples, iterations)
+{
+  uint64 count = 0;
+  for (const auto& pattern: patterns)
+    count += index->count(pattern);
+  celero::DoNotOptimizeAway(count);
+}
+
+BENCHMARK_F(Count, FMIndexLocate, TextFixture, samples, iterations)
+{
+  uint64 count = 0;
+  for (const auto& pattern: patterns)
+    count += index->locate(pattern).size();
+  celero::DoNotOptimizeAway(count);
+}
+
+BASELINE_F(Construction, SuffixArray, TextFixture, samples, iterations)
+{
+  celero::DoNotOptimizeAway(BuildSuffixArray(text)[0]);
+}
+
+BENCHMARK_F(Construction, FMIndex, TextFixture, samples, iterations)
+{
+  celero::DoNotOptimizeAway(FMIndex(text).size());
+}
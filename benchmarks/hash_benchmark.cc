@@ -0,0 +1,160 @@
+// Jakub Staroń, 2016
+#include <celero/Celero.h>
+
+#include "iterators.h"
+#include "hash.h"
+#include "text_algorithms/hasher.h"
+#include "text_algorithms/rolling_hasher.h"
+
+CELERO_MAIN
+
+using namespace lib;
+
+constexpr size_t samples = 5;
+constexpr size_t iterations = 1;
+
+/**
+ * Experiment value is length of text in bytes,
+ * so throughput in GB/s is value / (1000 * us per iteration).
+ */
+class BytesFixture : public celero::TestFixture
+{
+public:
+  std::vector<std::pair<int64_t, uint64_t>> getExperimentValues() const override
+  {
+    return {
+        {1000 * 1000, 0},
+        {10 * 1000 * 1000, 0},
+        {100 * 1000 * 1000, 0}
+    };
+  }
+
+  void setUp(int64_t experimentValue) override
+  {
+    text.resize(experimentValue);
+    for (auto& c: text)
+      c = char('a' + lib::Random32() % 26);
+    // shared tables of powers are built once, not in measured construction
+    BasicHasher<hash::prime_pair> prime_pair_hasher(text.begin(), text.end());
+    BasicHasher<hash::mersenne61> mersenne_hasher(text.begin(), text.end());
+  }
+
+  std::string text;
+};
+
+/**
+ * Prefix hashes computed one by one, ie Hasher before bulk construction.
+ */
+template <typename Backend>
+std::vector<typename Backend::hash_type> SerialPrefixHashes(const std::string& text) {
+  using hash_type = typename Backend::hash_type;
+  std::vector<hash_type> hashes;
+  hashes.reserve(text.size() + 1);
+  hash_type sum = Backend::zero();
+  hash_type power = Backend::one();
+  hashes.push_back(sum);
+  for (char c: text) {
+    sum = Backend::add(sum, Backend::multiply(power, hash::scalar_type(c)));
+    hashes.push_back(sum);
+    power = Backend::multiply(power, Backend::base());
+  }
+  return hashes;
+}
+
+BASELINE_F(HasherConstruction, SerialPrimePair, BytesFixture, samples, iterations)
+{
+  celero::DoNotOptimizeAway(SerialPrefixHashes<hash::prime_pair>(text).back().first.value());
+}
+
+BENCHMARK_F(HasherConstruction, SerialMersenne61, BytesFixture, samples, iterations)
+{
+  celero::DoNotOptimizeAway(SerialPrefixHashes<hash::mersenne61>(text).back());
+}
+
+BENCHMARK_F(HasherConstruction, PrimePair, BytesFixture, samples, iterations)
+{
+  BasicHasher<hash::prime_pair> hasher(text.begin(), text.end());
+  celero::DoNotOptimizeAway(hasher.getHash(0, text.size()).first.value());
+}
+
+BENCHMARK_F(HasherConstruction, Mersenne61, BytesFixture, samples, iterations)
+{
+  BasicHasher<hash::mersenne61> hasher(text.begin(), text.end());
+  celero::DoNotOptimizeAway(hasher.getHash(0, text.size()));
+}
+
+BENCHMARK_F(HasherConstruction, Mersenne61InverseFree, BytesFixture, samples, iterations)
+{
+  BasicHasher<hash::mersenne61, hash::inverse_free> hasher(text.begin(), text.end());
+  celero::DoNotOptimizeAway(hasher.getHash(0, text.size()));
+}
+
+BASELINE_F(StringHash, SerialMersenne61, BytesFixture, samples, iterations)
+{
+  hash::mersenne61::hash_type sum = 0, power = 1;
+  for (char c: text) {
+    sum = hash::mersenne61::add(sum, hash::mersenne61::multiply(power, hash::scalar_type(c)));
+    power = hash::mersenne61::multiply(power, hash::mersenne61::base());
+  }
+  celero::DoNotOptimizeAway(sum);
+}
+
+BENCHMARK_F(StringHash, PrimePair, BytesFixture, samples, iterations)
+{
+  celero::DoNotOptimizeAway(hash::hash(text).first.value());
+}
+
+BENCHMARK_F(StringHash, Mersenne61, BytesFixture, samples, iterations)
+{
+  celero::DoNotOptimizeAway(hash::hash<hash::mersenne61>(text));
+}
+
+constexpr size_t kWindow = 64;
+
+/**
+ * Hashes of all windows of length kWindow, baseline keeps hashes of all prefixes.
+ */
+BASELINE_F(WindowHashes, Hasher, BytesFixture, samples, iterations)
+{
+  Hasher hasher(text.begin(), text.end());
+  hash::hash_type sum = hash::zero;
+  for (uint32 i = 0; i + kWindow <= text.size(); i++)
+    sum = hash::add(sum, hasher.getHash(i, kWindow));
+  celero::DoNotOptimizeAway(sum.first.value());
+}
+
+BENCHMARK_F(WindowHashes, RollingHasher, BytesFixture, samples, iterations)
+{
+  RollingHasher hasher(kWindow);
+  hash::hash_type sum = hash::zero;
+  for (char c: text) {
+    hasher.push(c);
+    sum = hash::add(sum, hasher.getHash());
+  }
+  celero::DoNotOptimizeAway(sum.first.value());
+}
+
+BENCHMARK_F(WindowHashes, HashWindows, BytesFixture, samples, iterations)
+{
+  std::vector<hash::hash_type> windows(text.size());
+  HashWindows(text.begin(), text.end(), kWindow, windows.data());
+  celero::DoNotOptimizeAway(windows.back().first.value());
+}
+
+BENCHMARK_F(WindowHashes, RollingHasherMersenne61, BytesFixture, samples, iterations)
+{
+  BasicRollingHasher<hash::mersenne61> hasher(kWindow);
+  uint64 sum = 0;
+  for (char c: text) {
+    hasher.push(c);
+    sum += hasher.getHash();
+  }
+  celero::DoNotOptimizeAway(sum);
+}
+
+BENCHMARK_F(WindowHashes, HashWindowsMersenne61, BytesFixture, samples, iterations)
+{
+  std::vector<uint64> windows(text.size());
+  HashWindows<hash::mersenne61>(text.begin(), text.end(), kWindow, windows.data());
+  celero::DoNotOptimizeAway(windows.back());
+}
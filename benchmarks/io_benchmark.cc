@@ -3,6 +3,7 @@
 
 #include "data_structures/indexer.h"
 #include "iterators.h"
+#include "io.h"
 
 CELERO_MAIN
 
@@ -33,9 +34,19 @@ public:
       string += '\n';
     }
     stream.str(string);
+
+    file = std::tmpfile();
+    std::fwrite(string.data(), 1, string.size(), file);
+    std::rewind(file);
+  }
+
+  void tearDown() override
+  {
+    std::fclose(file);
   }
 
   std::istringstream stream;
+  FILE* file;
   uint32 N;
 };
 
@@ -51,3 +62,165 @@ BASELINE_F(Load, Istringstream, NumbersLoadFixture, samples, iterations)
   celero::DoNotOptimizeAway(sum);
 }
 
+
+BENCHMARK_F(Load, FastReader, NumbersLoadFixture, samples, iterations)
+{
+  FastReader reader(fileno(file));
+  uint64 sum = 0;
+  for (auto i: range<uint32>(0, N)) {
+    uint32 k;
+    reader >> k;
+    sum += k;
+  }
+  celero::DoNotOptimizeAway(sum);
+}
+
+BENCHMARK_F(Load, FastReaderSequence, NumbersLoadFixture, samples, iterations)
+{
+  FastReader reader(fileno(file));
+  std::vector<uint32> numbers;
+  reader >> ReadSequence(N, numbers);
+  celero::DoNotOptimizeAway(numbers.back());
+}
+
+class NumbersPrintFixture : public celero::TestFixture
+{
+public:
+  std::vector<std::pair<int64_t, uint64_t>> getExperimentValues() const override
+  {
+    return {
+        {1000, 0},
+        {1000 * 1000, 0},
+        {10 * 1000 * 1000, 0}
+    };
+  }
+
+  void setUp(int64_t experimentValue) override
+  {
+    numbers.clear();
+    for (auto i: range<uint32>(0, experimentValue))
+      numbers.push_back(lib::Random32());
+    file = std::tmpfile();
+  }
+
+  void tearDown() override
+  {
+    std::fclose(file);
+  }
+
+  std::vector<uint32> numbers;
+  FILE* file;
+};
+
+BASELINE_F(Print, Ostringstream, NumbersPrintFixture, samples, iterations)
+{
+  std::ostringstream stream;
+  for (auto n: numbers)
+    stream << n << newline;
+  celero::DoNotOptimizeAway(stream.tellp());
+}
+
+BENCHMARK_F(Print, OstringstreamContainer, NumbersPrintFixture, samples, iterations)
+{
+  std::ostringstream stream;
+  stream << numbers;
+  celero::DoNotOptimizeAway(stream.tellp());
+}
+
+BENCHMARK_F(Print, FastWriter, NumbersPrintFixture, samples, iterations)
+{
+  FastWriter writer(fileno(file));
+  for (auto n: numbers)
+    writer << n << newline;
+}
+
+BENCHMARK_F(Print, FastWriterContainer, NumbersPrintFixture, samples, iterations)
+{
+  FastWriter writer(fileno(file));
+  writer << numbers;
+}
+
+class LinesFileFixture : public celero::TestFixture
+{
+public:
+  std::vector<std::pair<int64_t, uint64_t>> getExperimentValues() const override
+  {
+    return {
+        {100 * 1000, 0},
+        {1000 * 1000, 0},
+        {10 * 1000 * 1000, 0}
+    };
+  }
+
+  void setUp(int64_t experimentValue) override
+  {
+    char name[] = "/tmp/lines_benchmark_XXXXXX";
+    int descriptor = mkstemp(name);
+    path = name;
+    {
+      FastWriter writer(descriptor);
+      for (auto i: range<uint32>(0, experimentValue)) {
+        const uint32 length = lib::Random32() % 80;
+        for (auto j: range<uint32>(0, length))
+          writer << char('a' + lib::Random32() % 26);
+        writer << newline;
+      }
+    }
+    close(descriptor);
+  }
+
+  void tearDown() override
+  {
+    unlink(path.c_str());
+  }
+
+  std::string path;
+};
+
+BASELINE_F(Lines, Getline, LinesFileFixture, samples, iterations)
+{
+  std::ifstream stream(path);
+  uint64 total = 0;
+  for (const auto& line: iterate_lines(stream))
+    total += line.size();
+  celero::DoNotOptimizeAway(total);
+}
+
+BENCHMARK_F(Lines, MappedFile, LinesFileFixture, samples, iterations)
+{
+  MappedFile file(path);
+  uint64 total = 0;
+  for (const auto& line: iterate_lines(file))
+    total += line.size();
+  celero::DoNotOptimizeAway(total);
+}
+
+BASELINE_F(Format, RuntimeFormat, NumbersPrintFixture, samples, iterations)
+{
+  std::ostringstream stream;
+  for (auto n: numbers)
+    print(stream, "value = %0, half = %1", n, n / 2);
+  celero::DoNotOptimizeAway(stream.tellp());
+}
+
+BENCHMARK_F(Format, CompileTimeFormat, NumbersPrintFixture, samples, iterations)
+{
+  std::ostringstream stream;
+  for (auto n: numbers)
+    print(stream, LIB_FORMAT("value = %0, half = %1"), n, n / 2);
+  celero::DoNotOptimizeAway(stream.tellp());
+}
+
+BENCHMARK_F(Format, RuntimeFormatFastWriter, NumbersPrintFixture, samples, iterations)
+{
+  FastWriter writer(fileno(file));
+  for (auto n: numbers)
+    print(writer, "value = %0, half = %1", n, n / 2);
+}
+
+BENCHMARK_F(Format, CompileTimeFormatFastWriter, NumbersPrintFixture, samples, iterations)
+{
+  FastWriter writer(fileno(file));
+  for (auto n: numbers)
+    print(writer, LIB_FORMAT("value = %0, half = %1"), n, n / 2);
+}
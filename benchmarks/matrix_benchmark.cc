@@ -0,0 +1,96 @@
+// Jakub Staroń, 2016
+#include <celero/Celero.h>
+
+#include "iterators.h"
+#include "numeric/matrix.h"
+
+CELERO_MAIN
+
+using namespace lib;
+using namespace lib::numeric;
+
+constexpr size_t samples = 3;
+constexpr size_t iterations = 1;
+
+constexpr uint32 kPrime = 1000 * 1000 * 1000 + 7;
+using field = prime_field<kPrime>;
+
+class MatrixFixture : public celero::TestFixture
+{
+public:
+  std::vector<std::pair<int64_t, uint64_t>> getExperimentValues() const override
+  {
+    return {
+        {64, 0},
+        {128, 0},
+        {256, 0},
+        {512, 0}
+    };
+  }
+
+  void setUp(int64_t experimentValue) override
+  {
+    const size_t k = experimentValue;
+    lhs = Matrix<field>(k, k);
+    rhs = Matrix<field>(k, k);
+    coefficients.clear();
+    initial.clear();
+    for (auto i: range<size_t>(0, k)) {
+      for (auto j: range<size_t>(0, k)) {
+        lhs(i, j) = lib::Random32();
+        rhs(i, j) = lib::Random32();
+      }
+      coefficients.push_back(lib::Random32());
+      initial.push_back(lib::Random32());
+    }
+  }
+
+  Matrix<field> lhs;
+  Matrix<field> rhs;
+  std::vector<field> coefficients;
+  std::vector<field> initial;
+};
+
+/**
+ * Hand-written triple loop, reducing after every multiplication.
+ */
+Matrix<field> NaiveMultiply(const Matrix<field>& lhs, const Matrix<field>& rhs) {
+  Matrix<field> result(lhs.rows(), rhs.columns());
+  for (auto i: range<size_t>(0, lhs.rows()))
+    for (auto j: range<size_t>(0, rhs.columns())) {
+      field sum = 0;
+      for (auto k: range<size_t>(0, lhs.columns()))
+        sum += lhs(i, k) * rhs(k, j);
+      result(i, j) = sum;
+    }
+  return result;
+}
+
+BASELINE_F(MatrixMultiply, Naive, MatrixFixture, samples, iterations)
+{
+  celero::DoNotOptimizeAway(NaiveMultiply(lhs, rhs)(0, 0).value());
+}
+
+BENCHMARK_F(MatrixMultiply, Tiled, MatrixFixture, samples, iterations)
+{
+  celero::DoNotOptimizeAway((lhs * rhs)(0, 0).value());
+}
+
+constexpr uint64 kTermIndex = 1000uLL * 1000 * 1000 * 1000 * 1000 * 1000;
+
+BASELINE_F(LinearRecurrence, MatrixPower, MatrixFixture, 1, iterations)
+{
+  const size_t k = coefficients.size();
+  Matrix<field> companion(k, k);
+  for (auto i: range<size_t>(0, k))
+    companion(0, i) = coefficients[i];
+  for (auto i: range<size_t>(1, k))
+    companion(i, i - 1) = 1;
+  std::vector<field> reversed(initial.rbegin(), initial.rend());
+  celero::DoNotOptimizeAway((power(companion, kTermIndex - k + 1) * reversed)[0].value());
+}
+
+BENCHMARK_F(LinearRecurrence, Kitamasa, MatrixFixture, samples, iterations)
+{
+  celero::DoNotOptimizeAway(LinearRecurrenceTerm(coefficients, initial, kTermIndex).value());
+}
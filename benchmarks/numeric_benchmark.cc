@@ -19,7 +19,8 @@ public:
         {100 * 1000, 10},
         {1000 * 1000, 5},
         {10 * 1000 * 1000, 1},
-        {100 * 1000 * 1000, 1}
+        {100 * 1000 * 1000, 1},
+        {1000 * 1000 * 1000, 1}
     };
   }
 
@@ -79,6 +80,199 @@ BENCHMARK_F(Sieve, Linear, SizeFixture, samples, iterations)
   celero::DoNotOptimizeAway(primes[N - 1]);
 }
 
+BENCHMARK_F(Sieve, Segmented, SizeFixture, samples, iterations)
+{
+  auto primes = numeric::Sieve(N);
+  celero::DoNotOptimizeAway(primes[N - 1]);
+}
+
+BENCHMARK_F(Sieve, SegmentedCount, SizeFixture, samples, iterations)
+{
+  celero::DoNotOptimizeAway(numeric::CountPrimes(0, N));
+}
+
+BENCHMARK_F(Sieve, SegmentedForEach, SizeFixture, samples, iterations)
+{
+  uint64 sum = 0;
+  numeric::ForEachPrime(0, N, [&sum](uint64 p) { sum += p; });
+  celero::DoNotOptimizeAway(sum);
+}
+
+class CountingFixture : public celero::TestFixture
+{
+public:
+  std::vector<std::pair<int64_t, uint64_t>> getExperimentValues() const override {
+    return {
+        {1000 * 1000, 10},
+        {10 * 1000 * 1000, 1},
+        {100 * 1000 * 1000, 1},
+        {1000 * 1000 * 1000, 1}
+    };
+  }
+
+  void setUp(int64_t experimentValue) override {
+    N = experimentValue;
+  }
+
+  uint64 N;
+};
+
+constexpr size_t counting_samples = 5;
+
+BASELINE_F(PrimeCounting, SegmentedSieve, CountingFixture, counting_samples, iterations)
+{
+  celero::DoNotOptimizeAway(numeric::CountPrimes(0, N + 1));
+}
+
+BENCHMARK_F(PrimeCounting, PrimePi, CountingFixture, counting_samples, iterations)
+{
+  celero::DoNotOptimizeAway(numeric::PrimePi(N));
+}
+
+BENCHMARK_F(PrimeCounting, PrimeSum, CountingFixture, counting_samples, iterations)
+{
+  celero::DoNotOptimizeAway(numeric::PrimeSum(N));
+}
+
+class TableFixture : public celero::TestFixture
+{
+public:
+  std::vector<std::pair<int64_t, uint64_t>> getExperimentValues() const override {
+    return {
+        {1000 * 1000, 1},
+        {10 * 1000 * 1000, 1},
+        {100 * 1000 * 1000, 1}
+    };
+  }
+
+  void setUp(int64_t experimentValue) override {
+    N = experimentValue;
+  }
+
+  uint32 N;
+};
+
+constexpr size_t table_samples = 5;
+
+/**
+ * Totient table as computed in examples/lcm_sum.cc.
+ */
+std::vector<uint32> totient_function_values(uint32 N) {
+  std::vector<uint32> result(N, 1);
+  result[0] = 0;
+
+  const auto primes = numeric::PrimeNumbers(N);
+  for (uint64 p: primes) {
+    for (uint64 q = p; q < N; q *= p) {
+      result[q] = (q / p) * (p - 1);
+      for (uint64 i = 2; i * q < N; i++) {
+        if (divides(p, i))
+          continue;
+
+        result[i * q] *= result[q];
+      }
+    }
+  }
+
+  return result;
+}
+
+std::vector<uint32> divisor_counts_harmonic(uint32 N) {
+  std::vector<uint32> result(N, 0);
+  for (uint32 d = 1; d < N; ++d)
+    for (uint32 i = d; i < N; i += d)
+      result[i]++;
+  return result;
+}
+
+BASELINE_F(Totient, Example, TableFixture, table_samples, iterations)
+{
+  auto totients = totient_function_values(N);
+  celero::DoNotOptimizeAway(totients[N - 1]);
+}
+
+BENCHMARK_F(Totient, LinearSieve, TableFixture, table_samples, iterations)
+{
+  auto totients = numeric::LinearSieve(N).totients();
+  celero::DoNotOptimizeAway(totients[N - 1]);
+}
+
+BASELINE_F(DivisorCount, Harmonic, TableFixture, table_samples, iterations)
+{
+  auto counts = divisor_counts_harmonic(N);
+  celero::DoNotOptimizeAway(counts[N - 1]);
+}
+
+BENCHMARK_F(DivisorCount, LinearSieve, TableFixture, table_samples, iterations)
+{
+  auto counts = numeric::LinearSieve(N).divisorCounts();
+  celero::DoNotOptimizeAway(counts[N - 1]);
+}
+
+BENCHMARK_F(DivisorCount, LinearSieveOnly, TableFixture, table_samples, iterations)
+{
+  numeric::LinearSieve sieve(N);
+  celero::DoNotOptimizeAway(sieve.smallestPrimeFactor(N - 1));
+}
+
+class RangeFixture : public celero::TestFixture
+{
+public:
+  std::vector<std::pair<int64_t, uint64_t>> getExperimentValues() const override {
+    return {
+        {1000 * 1000 * 1000, 1},
+        {10uLL * 1000 * 1000 * 1000, 1}
+    };
+  }
+
+  void setUp(int64_t experimentValue) override {
+    N = experimentValue;
+  }
+
+  uint64 N;
+};
+
+constexpr size_t parallel_samples = 5;
+
+BASELINE_F(ParallelSieve, SegmentedCount, RangeFixture, parallel_samples, iterations)
+{
+  celero::DoNotOptimizeAway(numeric::CountPrimes(0, N));
+}
+
+BENCHMARK_F(ParallelSieve, Count1Thread, RangeFixture, parallel_samples, iterations)
+{
+  celero::DoNotOptimizeAway(numeric::CountPrimesParallel(0, N, 1));
+}
+
+BENCHMARK_F(ParallelSieve, Count2Threads, RangeFixture, parallel_samples, iterations)
+{
+  celero::DoNotOptimizeAway(numeric::CountPrimesParallel(0, N, 2));
+}
+
+BENCHMARK_F(ParallelSieve, Count4Threads, RangeFixture, parallel_samples, iterations)
+{
+  celero::DoNotOptimizeAway(numeric::CountPrimesParallel(0, N, 4));
+}
+
+BENCHMARK_F(ParallelSieve, Count8Threads, RangeFixture, parallel_samples, iterations)
+{
+  celero::DoNotOptimizeAway(numeric::CountPrimesParallel(0, N, 8));
+}
+
+BENCHMARK_F(ParallelSieve, Ordered1Thread, RangeFixture, parallel_samples, iterations)
+{
+  uint64 sum = 0;
+  numeric::ForEachPrimeParallel(0, N, 1, [&sum](uint64 p) { sum += p; });
+  celero::DoNotOptimizeAway(sum);
+}
+
+BENCHMARK_F(ParallelSieve, Ordered4Threads, RangeFixture, parallel_samples, iterations)
+{
+  uint64 sum = 0;
+  numeric::ForEachPrimeParallel(0, N, 4, [&sum](uint64 p) { sum += p; });
+  celero::DoNotOptimizeAway(sum);
+}
+
 class NumbersFixture : public celero::TestFixture
 {
 public:
@@ -93,7 +287,7 @@ public:
   }
 
   void setUp(int64_t experimentValue) override {
-    number = (lib::Random32() % (experimentValue - 2)) + 2;
+    number = (lib::Random64() % (experimentValue - 2)) + 2;
   }
 
   uint64 number;
@@ -101,8 +295,185 @@ public:
 
 constexpr size_t factorization_samples = 10000;
 
-BASELINE_F(Factorization, Factorize, NumbersFixture, samples, iterations)
+std::vector<uint64> trial_division(uint64 n) {
+  std::vector<uint64> result;
+  for (uint64 d = 2; d * d <= n; ++d) {
+    while (n % d == 0) {
+      result.push_back(d);
+      n /= d;
+    }
+  }
+  if (n > 1)
+    result.push_back(n);
+  return result;
+}
+
+BASELINE_F(Factorization, TrialDivision, NumbersFixture, samples, iterations)
+{
+  auto v = trial_division(number);
+  celero::DoNotOptimizeAway(v.front() + v.back());
+}
+
+// Factorize takes uint32, so for bigger experiment values
+// it factorizes number truncated to 32 bits.
+BENCHMARK_F(Factorization, Factorize, NumbersFixture, samples, iterations)
 {
   auto v = numeric::Factorize(number);
   celero::DoNotOptimizeAway(v.front() + v.back());
 }
+
+BENCHMARK_F(Factorization, Factorize64, NumbersFixture, samples, iterations)
+{
+  auto v = numeric::Factorize64(number);
+  celero::DoNotOptimizeAway(v.front() + v.back());
+}
+
+class PrimalityFixture : public celero::TestFixture
+{
+public:
+  std::vector<std::pair<int64_t, uint64_t>> getExperimentValues() const override {
+    return {
+        {32, 1},
+        {48, 1},
+        {62, 1},
+        {64, 1}
+    };
+  }
+
+  void setUp(int64_t experimentValue) override {
+    numbers.clear();
+    for (auto i: range<size_t>(0, primality_tests))
+      numbers.push_back(lib::Random64() >> (64 - experimentValue));
+  }
+
+  static constexpr size_t primality_tests = 10000;
+  std::vector<uint64> numbers;
+};
+
+/**
+ * Miller-Rabin test with double-and-add multiplication,
+ * ie IsPrime before Montgomery64 was introduced.
+ * Correct only for numbers smaller than 2^63.
+ */
+bool is_prime_double_and_add(uint64 p) {
+  auto multiply = [p](uint64 a, uint64 b) {
+    uint64 result = 0;
+    while (b > 0) {
+      if (b % 2 == 1)
+        result = (result + a) % p;
+      a = (a + a) % p;
+      b /= 2;
+    }
+    return result;
+  };
+
+  if (p < 2 || p % 2 == 0)
+    return p == 2;
+  const uint64 odd_factor = (p - 1) >> least_significant_one(p - 1);
+  for (uint64 witness: {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37}) {
+    if (p == witness)
+      return true;
+    uint64 x = 1, base = witness, k = odd_factor;
+    for (uint64 n = k; n > 0; n /= 2) {
+      if (n % 2 == 1)
+        x = multiply(x, base);
+      base = multiply(base, base);
+    }
+    if (x == 1 || x == p - 1)
+      continue;
+    while (k < p - 1 && x != p - 1) {
+      x = multiply(x, x);
+      if (x == 1)
+        return false;
+      k *= 2;
+    }
+    if (x != p - 1)
+      return false;
+  }
+  return true;
+}
+
+BASELINE_F(IsPrime, DoubleAndAdd, PrimalityFixture, samples, iterations)
+{
+  size_t count = 0;
+  for (auto n: numbers)
+    count += is_prime_double_and_add(n);
+  celero::DoNotOptimizeAway(count);
+}
+
+BENCHMARK_F(IsPrime, Montgomery, PrimalityFixture, samples, iterations)
+{
+  size_t count = 0;
+  for (auto n: numbers)
+    count += numeric::IsPrime(n);
+  celero::DoNotOptimizeAway(count);
+}
+
+class LogarithmFixture : public celero::TestFixture
+{
+public:
+  std::vector<std::pair<int64_t, uint64_t>> getExperimentValues() const override {
+    return {
+        {1, 1},
+        {16, 1},
+        {256, 1}
+    };
+  }
+
+  void setUp(int64_t experimentValue) override {
+    xs.clear();
+    for (auto i: range<int64_t>(0, experimentValue))
+      xs.push_back(1 + lib::Random32() % (kPrime - 1));
+  }
+
+  static constexpr uint32 kPrime = 2147483647;
+  static constexpr uint32 kRoot = 7;
+  std::vector<uint32> xs;
+};
+
+constexpr size_t logarithm_samples = 3;
+
+/**
+ * Baby-step giant-step with std::unordered_map,
+ * ie DiscreteLogarithm before FlatHashMap was introduced.
+ */
+uint32 discrete_logarithm_unordered_map(uint32 a, uint32 x, uint32 p) {
+  const uint32 order_of_a = numeric::MultiplicativeOrder(a, p);
+  const uint32 sqrt = uint64(SquareCeiling(p - 1));
+  std::unordered_map<uint32, uint32> small_steps;
+  for (auto i: range<uint32>(0, sqrt))
+    small_steps.emplace(numeric::PowerModulo32(a, i, p), i);
+
+  uint32 giant_step = numeric::Inverse(numeric::PowerModulo32(a, sqrt, p), p);
+  for (auto i: range<uint32>(0, sqrt)) {
+    auto it = small_steps.find(x);
+    if (it != small_steps.end())
+      return (uint64(it->second) + uint64(i) * sqrt) % order_of_a;
+    x = numeric::Multiply32(x, giant_step, p);
+  }
+  throw std::runtime_error("DiscreteLogarithm - no logarithm found");
+}
+
+BASELINE_F(DiscreteLogarithm, UnorderedMap, LogarithmFixture, logarithm_samples, iterations)
+{
+  uint64 sum = 0;
+  for (auto x: xs)
+    sum += discrete_logarithm_unordered_map(kRoot, x, kPrime);
+  celero::DoNotOptimizeAway(sum);
+}
+
+BENCHMARK_F(DiscreteLogarithm, FlatHashMap, LogarithmFixture, logarithm_samples, iterations)
+{
+  uint64 sum = 0;
+  for (auto x: xs)
+    sum += numeric::DiscreteLogarithm(kRoot, x, kPrime);
+  celero::DoNotOptimizeAway(sum);
+}
+
+BENCHMARK_F(DiscreteLogarithm, Batched, LogarithmFixture, logarithm_samples, iterations)
+{
+  uint64 sum = 0;
+  for (auto k: numeric::DiscreteLogarithm(kRoot, xs, kPrime))
+    sum += k;
+  celero::DoNotOptimizeAway(sum);
+}
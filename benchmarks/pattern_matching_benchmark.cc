@@ -0,0 +1,100 @@
+// Jakub Staroń, 2016
+#include <celero/Celero.h>
+
+#include "iterators.h"
+#include "text_algorithms/knuth_morris_pratt.h"
+
+CELERO_MAIN
+
+using namespace lib;
+
+constexpr size_t samples = 10;
+constexpr size_t iterations = 1;
+
+constexpr uint32 kAlphabetSize = 4;
+constexpr size_t kChunkSize = 64 * 1024;
+
+/**
+ * Experiment value is length of pattern, text has 10^7 letters
+ * of 4 letters alphabet and pattern is taken from text.
+ */
+class TextFixture : public celero::TestFixture
+{
+public:
+  std::vector<std::pair<int64_t, uint64_t>> getExperimentValues() const override
+  {
+    return {
+        {4, 0},
+        {16, 0},
+        {256, 0}
+    };
+  }
+
+  void setUp(int64_t experimentValue) override
+  {
+    text.clear();
+    for (auto i: range<uint32>(0, 10 * 1000 * 1000))
+      text += char('a' + Random32() % kAlphabetSize);
+    pattern = text.substr(text.size() / 2, experimentValue);
+  }
+
+  std::string text;
+  std::string pattern;
+};
+
+BASELINE_F(Occurrences, StdSearch, TextFixture, samples, iterations)
+{
+  uint64 count = 0;
+  auto it = std::search(text.begin(), text.end(), pattern.begin(), pattern.end());
+  while (it != text.end()) {
+    count++;
+    it = std::search(it + 1, text.end(), pattern.begin(), pattern.end());
+  }
+  celero::DoNotOptimizeAway(count);
+}
+
+BENCHMARK_F(Occurrences, StringFind, TextFixture, samples, iterations)
+{
+  uint64 count = 0;
+  for (size_t position = text.find(pattern); position != std::string::npos; position = text.find(pattern, position + 1))
+    count++;
+  celero::DoNotOptimizeAway(count);
+}
+
+BENCHMARK_F(Occurrences, Matcher, TextFixture, samples, iterations)
+{
+  uint64 count = 0;
+  KnuthMorrisPrattMatcher<char> matcher(pattern.begin(), pattern.end());
+  matcher.feed(text.begin(), text.end(), [&count](uint64) { count++; });
+  celero::DoNotOptimizeAway(count);
+}
+
+BENCHMARK_F(Occurrences, MatcherChunked, TextFixture, samples, iterations)
+{
+  uint64 count = 0;
+  KnuthMorrisPrattMatcher<char> matcher(pattern.begin(), pattern.end());
+  for (size_t begin = 0; begin < text.size(); begin += kChunkSize) {
+    const char* chunk = text.data() + begin;
+    matcher.feed(chunk, chunk + std::min(kChunkSize, text.size() - begin), [&count](uint64) { count++; });
+  }
+  celero::DoNotOptimizeAway(count);
+}
+
+BENCHMARK_F(Occurrences, Automaton, TextFixture, samples, iterations)
+{
+  uint64 count = 0;
+  KnuthMorrisPrattAutomaton automaton(pattern.begin(), pattern.end(), 'a', kAlphabetSize);
+  automaton.feed(text.begin(), text.end(), [&count](uint64) { count++; });
+  celero::DoNotOptimizeAway(count);
+}
+
+BENCHMARK_F(Occurrences, AutomatonChunked, TextFixture, samples, iterations)
+{
+  uint64 count = 0;
+  KnuthMorrisPrattAutomaton automaton(pattern.begin(), pattern.end(), 'a', kAlphabetSize);
+  for (size_t begin = 0; begin < text.size(); begin += kChunkSize) {
+    const char* chunk = text.data() + begin;
+    automaton.feed(chunk, chunk + std::min(kChunkSize, text.size() - begin), [&count](uint64) { count++; });
+  }
+  celero::DoNotOptimizeAway(count);
+}
@@ -0,0 +1,117 @@
+// Jakub Staroń, 2016
+#include <celero/Celero.h>
+
+#include "iterators.h"
+#include "numeric/polynomial.h"
+
+CELERO_MAIN
+
+using namespace lib;
+using namespace lib::numeric;
+
+constexpr size_t samples = 5;
+constexpr size_t iterations = 1;
+
+constexpr uint32 kPrime = ntt_prime1;
+using polynomial_type = polynomial::polynomial_type<kPrime>;
+
+class PolynomialsFixture : public celero::TestFixture
+{
+public:
+  explicit PolynomialsFixture(std::vector<int64_t> sizes):
+      sizes_(std::move(sizes)) { }
+
+  std::vector<std::pair<int64_t, uint64_t>> getExperimentValues() const override
+  {
+    std::vector<std::pair<int64_t, uint64_t>> result;
+    for (auto size: sizes_)
+      result.emplace_back(size, 0);
+    return result;
+  }
+
+  void setUp(int64_t experimentValue) override
+  {
+    lhs.clear();
+    rhs.clear();
+    lhs_numbers.clear();
+    rhs_numbers.clear();
+    for (auto i: range<int64_t>(0, experimentValue)) {
+      lhs_numbers.push_back(lib::Random32());
+      rhs_numbers.push_back(lib::Random32());
+    }
+    lhs.assign(lhs_numbers.begin(), lhs_numbers.end());
+    rhs.assign(rhs_numbers.begin(), rhs_numbers.end());
+    lhs[0] = 1;
+  }
+
+  polynomial_type lhs;
+  polynomial_type rhs;
+  std::vector<uint32> lhs_numbers;
+  std::vector<uint32> rhs_numbers;
+
+private:
+  std::vector<int64_t> sizes_;
+};
+
+/**
+ * Schoolbook multiplication is quadratic, so it is compared
+ * with transform only on small sizes.
+ */
+class SmallPolynomialsFixture : public PolynomialsFixture
+{
+public:
+  SmallPolynomialsFixture():
+      PolynomialsFixture({1 << 8, 1 << 10, 1 << 12, 1 << 14}) { }
+};
+
+class LargePolynomialsFixture : public PolynomialsFixture
+{
+public:
+  LargePolynomialsFixture():
+      PolynomialsFixture({1 << 16, 1 << 18, 1 << 20, 1 << 22}) { }
+};
+
+polynomial_type SchoolbookMultiply(const polynomial_type& a, const polynomial_type& b) {
+  polynomial_type result(a.size() + b.size() - 1);
+  for (auto i: range<size_t>(0, a.size()))
+    for (auto j: range<size_t>(0, b.size()))
+      result[i + j] += a[i] * b[j];
+  return result;
+}
+
+BASELINE_F(SmallMultiply, Schoolbook, SmallPolynomialsFixture, samples, iterations)
+{
+  celero::DoNotOptimizeAway(SchoolbookMultiply(lhs, rhs).back().value());
+}
+
+BENCHMARK_F(SmallMultiply, Transform, SmallPolynomialsFixture, samples, iterations)
+{
+  celero::DoNotOptimizeAway(polynomial::Multiply(lhs, rhs).back().value());
+}
+
+BASELINE_F(Multiply, Transform, LargePolynomialsFixture, samples, iterations)
+{
+  celero::DoNotOptimizeAway(polynomial::Multiply(lhs, rhs).back().value());
+}
+
+BENCHMARK_F(Multiply, MultiplyModulo, LargePolynomialsFixture, samples, iterations)
+{
+  celero::DoNotOptimizeAway(polynomial::MultiplyModulo(lhs_numbers, rhs_numbers, 1000 * 1000 * 1000 + 7).back());
+}
+
+BENCHMARK_F(Multiply, Inverse, LargePolynomialsFixture, samples, iterations)
+{
+  celero::DoNotOptimizeAway(polynomial::Inverse(lhs, lhs.size()).back().value());
+}
+
+BENCHMARK_F(Multiply, Logarithm, LargePolynomialsFixture, samples, iterations)
+{
+  celero::DoNotOptimizeAway(polynomial::Logarithm(lhs, lhs.size()).back().value());
+}
+
+BENCHMARK_F(Multiply, Exponent, LargePolynomialsFixture, samples, iterations)
+{
+  polynomial_type a = rhs;
+  a[0] = 0;
+  celero::DoNotOptimizeAway(polynomial::Exponent(a, a.size()).back().value());
+}
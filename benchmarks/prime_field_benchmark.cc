@@ -0,0 +1,239 @@
+// Jakub Staroń, 2016
+#include <celero/Celero.h>
+
+#include "iterators.h"
+#include "numeric/prime_field.h"
+#include "numeric/montgomery_field.h"
+#include "numeric/combinatorics.h"
+#include "numeric/dynamic_field.h"
+#include "numeric/number_theory.h"
+
+CELERO_MAIN
+
+using namespace lib;
+
+constexpr size_t samples = 20;
+constexpr size_t iterations = 5;
+
+constexpr uint32 kPrime = 1000 * 1000 * 1000 + 7;
+
+class VectorsFixture : public celero::TestFixture
+{
+public:
+  std::vector<std::pair<int64_t, uint64_t>> getExperimentValues() const override
+  {
+    return {
+        {1000, 0},
+        {100 * 1000, 0},
+        {10 * 1000 * 1000, 0}
+    };
+  }
+
+  void setUp(int64_t experimentValue) override
+  {
+    numeric::dynamic_field<>::setPrime(kPrime);
+    numbers1.clear();
+    numbers2.clear();
+    for (auto i: range<int64_t>(0, experimentValue)) {
+      numbers1.push_back(lib::Random32());
+      numbers2.push_back(lib::Random32());
+    }
+  }
+
+  std::vector<uint32> numbers1;
+  std::vector<uint32> numbers2;
+};
+
+template <typename Field>
+Field DotProduct(const std::vector<Field>& lhs, const std::vector<Field>& rhs) {
+  Field result = 0;
+  for (auto i: range<size_t>(0, lhs.size()))
+    result += lhs[i] * rhs[i];
+  return result;
+}
+
+template <typename Field>
+Field EvaluatePolynomial(const std::vector<Field>& coefficients, Field x) {
+  Field result = 0;
+  for (auto it = coefficients.rbegin(); it != coefficients.rend(); ++it)
+    result = result * x + *it;
+  return result;
+}
+
+template <typename Field>
+void Multiply(const std::vector<Field>& lhs, const std::vector<Field>& rhs, std::vector<Field>& result) {
+  for (auto i: range<size_t>(0, lhs.size()))
+    result[i] = lhs[i] * rhs[i];
+}
+
+BASELINE_F(DotProduct, PrimeField, VectorsFixture, samples, iterations)
+{
+  using field = numeric::prime_field<kPrime>;
+  std::vector<field> lhs(numbers1.begin(), numbers1.end());
+  std::vector<field> rhs(numbers2.begin(), numbers2.end());
+  celero::DoNotOptimizeAway(DotProduct(lhs, rhs).value());
+}
+
+BENCHMARK_F(DotProduct, MontgomeryField, VectorsFixture, samples, iterations)
+{
+  using field = numeric::montgomery_field<kPrime>;
+  std::vector<field> lhs(numbers1.begin(), numbers1.end());
+  std::vector<field> rhs(numbers2.begin(), numbers2.end());
+  celero::DoNotOptimizeAway(DotProduct(lhs, rhs).value());
+}
+
+BENCHMARK_F(DotProduct, DynamicField, VectorsFixture, samples, iterations)
+{
+  using field = numeric::dynamic_field<>;
+  std::vector<field> lhs(numbers1.begin(), numbers1.end());
+  std::vector<field> rhs(numbers2.begin(), numbers2.end());
+  celero::DoNotOptimizeAway(DotProduct(lhs, rhs).value());
+}
+
+/**
+ * Runtime modulo without dynamic_field, ie 64 bits division per multiplication.
+ */
+BENCHMARK_F(DotProduct, Multiply32, VectorsFixture, samples, iterations)
+{
+  const uint32 modulo = numeric::dynamic_field<>::prime();
+  uint32 result = 0;
+  for (auto i: range<size_t>(0, numbers1.size()))
+    result = (result + numeric::Multiply32(numbers1[i] % modulo, numbers2[i] % modulo, modulo)) % modulo;
+  celero::DoNotOptimizeAway(result);
+}
+
+BASELINE_F(PolynomialEvaluation, PrimeField, VectorsFixture, samples, iterations)
+{
+  using field = numeric::prime_field<kPrime>;
+  std::vector<field> coefficients(numbers1.begin(), numbers1.end());
+  celero::DoNotOptimizeAway(EvaluatePolynomial(coefficients, field(numbers2[0])).value());
+}
+
+BENCHMARK_F(PolynomialEvaluation, MontgomeryField, VectorsFixture, samples, iterations)
+{
+  using field = numeric::montgomery_field<kPrime>;
+  std::vector<field> coefficients(numbers1.begin(), numbers1.end());
+  celero::DoNotOptimizeAway(EvaluatePolynomial(coefficients, field(numbers2[0])).value());
+}
+
+BENCHMARK_F(PolynomialEvaluation, DynamicField, VectorsFixture, samples, iterations)
+{
+  using field = numeric::dynamic_field<>;
+  std::vector<field> coefficients(numbers1.begin(), numbers1.end());
+  celero::DoNotOptimizeAway(EvaluatePolynomial(coefficients, field(numbers2[0])).value());
+}
+
+BENCHMARK_F(PolynomialEvaluation, Multiply32, VectorsFixture, samples, iterations)
+{
+  const uint32 modulo = numeric::dynamic_field<>::prime();
+  const uint32 x = numbers2[0] % modulo;
+  uint32 result = 0;
+  for (auto it = numbers1.rbegin(); it != numbers1.rend(); ++it)
+    result = (numeric::Multiply32(result, x, modulo) + *it % modulo) % modulo;
+  celero::DoNotOptimizeAway(result);
+}
+
+BASELINE_F(PointwiseMultiply, PrimeField, VectorsFixture, samples, iterations)
+{
+  using field = numeric::prime_field<kPrime>;
+  std::vector<field> lhs(numbers1.begin(), numbers1.end());
+  std::vector<field> rhs(numbers2.begin(), numbers2.end());
+  std::vector<field> result(lhs.size());
+  Multiply(lhs, rhs, result);
+  celero::DoNotOptimizeAway(result.back().value());
+}
+
+BENCHMARK_F(PointwiseMultiply, MontgomeryField, VectorsFixture, samples, iterations)
+{
+  using field = numeric::montgomery_field<kPrime>;
+  std::vector<field> lhs(numbers1.begin(), numbers1.end());
+  std::vector<field> rhs(numbers2.begin(), numbers2.end());
+  std::vector<field> result(lhs.size());
+  Multiply(lhs, rhs, result);
+  celero::DoNotOptimizeAway(result.back().value());
+}
+
+BENCHMARK_F(PointwiseMultiply, DynamicField, VectorsFixture, samples, iterations)
+{
+  using field = numeric::dynamic_field<>;
+  std::vector<field> lhs(numbers1.begin(), numbers1.end());
+  std::vector<field> rhs(numbers2.begin(), numbers2.end());
+  std::vector<field> result(lhs.size());
+  Multiply(lhs, rhs, result);
+  celero::DoNotOptimizeAway(result.back().value());
+}
+
+BENCHMARK_F(PointwiseMultiply, Multiply32, VectorsFixture, samples, iterations)
+{
+  const uint32 modulo = numeric::dynamic_field<>::prime();
+  std::vector<uint32> result(numbers1.size());
+  for (auto i: range<size_t>(0, numbers1.size()))
+    result[i] = numeric::Multiply32(numbers1[i] % modulo, numbers2[i] % modulo, modulo);
+  celero::DoNotOptimizeAway(result.back());
+}
+
+constexpr size_t inverse_samples = 5;
+constexpr size_t inverse_iterations = 1;
+
+BASELINE_F(Inverse, PerElement, VectorsFixture, inverse_samples, inverse_iterations)
+{
+  using field = numeric::prime_field<kPrime>;
+  std::vector<field> values(numbers1.begin(), numbers1.end());
+  for (auto& value: values)
+    value = inverse(value);
+  celero::DoNotOptimizeAway(values.back().value());
+}
+
+BENCHMARK_F(Inverse, BatchInverse, VectorsFixture, inverse_samples, inverse_iterations)
+{
+  using field = numeric::prime_field<kPrime>;
+  std::vector<field> values(numbers1.begin(), numbers1.end());
+  numeric::batch_inverse(values.begin(), values.end());
+  celero::DoNotOptimizeAway(values.back().value());
+}
+
+BENCHMARK_F(Inverse, MontgomeryBatchInverse, VectorsFixture, inverse_samples, inverse_iterations)
+{
+  using field = numeric::montgomery_field<kPrime>;
+  std::vector<field> values(numbers1.begin(), numbers1.end());
+  numeric::batch_inverse(values.begin(), values.end());
+  celero::DoNotOptimizeAway(values.back().value());
+}
+
+/**
+ * Inverses of 1..n, computed by the linear recurrence.
+ */
+BENCHMARK_F(Inverse, CombinatoricsTable, VectorsFixture, inverse_samples, inverse_iterations)
+{
+  numeric::Combinatorics<kPrime> combinatorics(uint32(numbers1.size()));
+  celero::DoNotOptimizeAway(combinatorics.inverse(combinatorics.size()).value());
+}
+
+BASELINE_F(Binomial, FactorialsAndInverse, VectorsFixture, inverse_samples, inverse_iterations)
+{
+  using field = numeric::prime_field<kPrime>;
+  const uint32 n = uint32(numbers1.size());
+  std::vector<field> factorials(n + 1);
+  factorials[0] = 1;
+  for (uint32 i = 1; i <= n; i++)
+    factorials[i] = factorials[i - 1] * i;
+
+  field sum = 0;
+  for (auto i: range<uint32>(0, n)) {
+    const uint32 k = numbers1[i] % (n + 1);
+    sum += factorials[n] * inverse(factorials[k] * factorials[n - k]);
+  }
+  celero::DoNotOptimizeAway(sum.value());
+}
+
+BENCHMARK_F(Binomial, Combinatorics, VectorsFixture, inverse_samples, inverse_iterations)
+{
+  using field = numeric::prime_field<kPrime>;
+  const uint32 n = uint32(numbers1.size());
+  numeric::Combinatorics<kPrime> combinatorics(n);
+
+  field sum = 0;
+  for (auto i: range<uint32>(0, n))
+    sum += combinatorics.binomial(n, numbers1[i] % (n + 1));
+  celero::DoNotOptimizeAway(sum.value());
+}
@@ -0,0 +1,86 @@
+// Jakub Staroń, 2016
+#include <celero/Celero.h>
+
+#include "iterators.h"
+#include "text_algorithms/suffix_array.h"
+
+CELERO_MAIN
+
+using namespace lib;
+
+constexpr size_t samples = 1;
+constexpr size_t iterations = 1;
+
+/**
+ * Random text over 4 letters alphabet. Text and its suffix array
+ * are shared between benchmarks, they take long to build for 10^8 letters.
+ */
+class TextFixture : public celero::TestFixture
+{
+public:
+  std::vector<std::pair<int64_t, uint64_t>> getExperimentValues() const override
+  {
+    return {
+        {1000 * 1000, 0},
+        {10 * 1000 * 1000, 0},
+        {100 * 1000 * 1000, 0}
+    };
+  }
+
+  void setUp(int64_t experimentValue) override
+  {
+    if (text.size() == size_t(experimentValue))
+      return;
+    text.resize(experimentValue);
+    for (auto& c: text)
+      c = char('a' + Random32() % 4);
+    suffix_array = BuildSuffixArray(text);
+  }
+
+  static std::string text;
+  static std::vector<uint32> suffix_array;
+};
+
+std::string TextFixture::text;
+std::vector<uint32> TextFixture::suffix_array;
+
+BASELINE_F(SuffixArray, Bytes, TextFixture, samples, iterations)
+{
+  celero::DoNotOptimizeAway(BuildSuffixArray(text)[0]);
+}
+
+BENCHMARK_F(SuffixArray, Integers, TextFixture, samples, iterations)
+{
+  std::vector<uint32> letters(text.begin(), text.end());
+  celero::DoNotOptimizeAway(BuildSuffixArray(letters, 256)[0]);
+}
+
+/**
+ * Classic Kasai algorithm with array of ranks.
+ */
+BASELINE_F(LcpArray, Kasai, TextFixture, samples, iterations)
+{
+  const uint32 n = uint32(text.size());
+  std::vector<uint32> rank(n), lcp(n);
+  for (auto i: range<uint32>(0, n))
+    rank[suffix_array[i]] = i;
+  uint32 length = 0;
+  for (auto i: range<uint32>(0, n)) {
+    if (rank[i] == 0) {
+      length = 0;
+      continue;
+    }
+    const uint32 previous = suffix_array[rank[i] - 1];
+    while (i + length < n && previous + length < n && text[i + length] == text[previous + length])
+      length++;
+    lcp[rank[i]] = length;
+    if (length > 0)
+      length--;
+  }
+  celero::DoNotOptimizeAway(lcp[n / 2]);
+}
+
+BENCHMARK_F(LcpArray, PermutedLcp, TextFixture, samples, iterations)
+{
+  celero::DoNotOptimizeAway(BuildLcpArray(text.begin(), text.end(), suffix_array)[text.size() / 2]);
+}
@@ -0,0 +1,168 @@
+// Jakub Staroń, 2016
+#include <celero/Celero.h>
+
+#include "io.h"
+#include "iterators.h"
+#include "text_algorithms/suffix_automaton.h"
+
+CELERO_MAIN
+
+using namespace lib;
+
+constexpr size_t samples = 1;
+constexpr size_t iterations = 1;
+
+/**
+ * Counts bytes allocated by operator new and their maximum,
+ * so peak memory of both automata includes transient
+ * copies made when vectors grow.
+ */
+struct AllocationCounter {
+  static size_t allocated;
+  static size_t peak;
+
+  /**
+   * Starts new measurement, returns bytes allocated before it.
+   */
+  static size_t reset() {
+    peak = allocated;
+    return allocated;
+  }
+};
+
+size_t AllocationCounter::allocated = 0;
+size_t AllocationCounter::peak = 0;
+
+// size of block is kept before it, 16 bytes keep alignment of malloc
+constexpr size_t kAllocationHeader = 16;
+
+void* operator new(size_t size) {
+  char* block = static_cast<char*>(std::malloc(size + kAllocationHeader));
+  if (block == nullptr)
+    throw std::bad_alloc();
+  *reinterpret_cast<size_t*>(block) = size;
+  AllocationCounter::allocated += size;
+  AllocationCounter::peak = std::max(AllocationCounter::peak, AllocationCounter::allocated);
+  return block + kAllocationHeader;
+}
+
+void operator delete(void* pointer) noexcept {
+  if (pointer == nullptr)
+    return;
+  char* block = static_cast<char*>(pointer) - kAllocationHeader;
+  AllocationCounter::allocated -= *reinterpret_cast<size_t*>(block);
+  std::free(block);
+}
+
+/**
+ * Classic suffix automaton with std::map of transitions in every state.
+ */
+class MapSuffixAutomaton {
+public:
+  MapSuffixAutomaton(): last_(0) {
+    states_.emplace_back();
+  }
+
+  void push(uint8 letter) {
+    const uint32 current = uint32(states_.size());
+    states_.emplace_back();
+    states_[current].length = states_[last_].length + 1;
+    int64 state = last_;
+    for (; state != -1 && !states_[state].next.count(letter); state = states_[state].link)
+      states_[state].next[letter] = current;
+    if (state == -1) {
+      states_[current].link = 0;
+    }
+    else {
+      const uint32 target = states_[state].next[letter];
+      if (states_[state].length + 1 == states_[target].length) {
+        states_[current].link = target;
+      }
+      else {
+        const uint32 clone = uint32(states_.size());
+        states_.push_back(states_[target]);
+        states_[clone].length = states_[state].length + 1;
+        for (; state != -1 && states_[state].next[letter] == target; state = states_[state].link)
+          states_[state].next[letter] = clone;
+        states_[target].link = states_[current].link = clone;
+      }
+    }
+    last_ = current;
+  }
+
+  uint32 states() const {
+    return uint32(states_.size());
+  }
+
+private:
+  struct State {
+    uint32 length = 0;
+    int64 link = -1;
+    std::map<uint8, uint32> next;
+  };
+
+  std::vector<State> states_;
+  uint32 last_;
+};
+
+/**
+ * Experiment value is length of random text over Alphabet letters.
+ */
+template <uint32 Alphabet>
+class TextFixture : public celero::TestFixture
+{
+public:
+  std::vector<std::pair<int64_t, uint64_t>> getExperimentValues() const override
+  {
+    return {
+        {1000 * 1000, 0},
+        {10 * 1000 * 1000, 0}
+    };
+  }
+
+  void setUp(int64_t experimentValue) override
+  {
+    text.resize(experimentValue);
+    for (auto& c: text)
+      c = char('a' + Random32() % Alphabet);
+  }
+
+  std::string text;
+};
+
+using DnaFixture = TextFixture<4>;
+using EnglishFixture = TextFixture<26>;
+
+template <typename Automaton>
+void MeasureConstruction(const std::string& text, const char* name) {
+  const size_t before = AllocationCounter::reset();
+  {
+    Automaton automaton;
+    for (char c: text)
+      automaton.push(uint8(c));
+    celero::DoNotOptimizeAway(automaton.states());
+  }
+  const size_t peak = AllocationCounter::peak - before;
+  print("%0 of %1 letters: peak memory %2 bytes, %3 bytes per letter.",
+        name, text.size(), peak, peak / text.size());
+}
+
+BASELINE_F(ConstructionDna, Map, DnaFixture, samples, iterations)
+{
+  MeasureConstruction<MapSuffixAutomaton>(text, "Map automaton");
+}
+
+BENCHMARK_F(ConstructionDna, FlatPool, DnaFixture, samples, iterations)
+{
+  MeasureConstruction<SuffixAutomaton>(text, "SuffixAutomaton");
+}
+
+BASELINE_F(ConstructionEnglish, Map, EnglishFixture, samples, iterations)
+{
+  MeasureConstruction<MapSuffixAutomaton>(text, "Map automaton");
+}
+
+BENCHMARK_F(ConstructionEnglish, FlatPool, EnglishFixture, samples, iterations)
+{
+  MeasureConstruction<SuffixAutomaton>(text, "SuffixAutomaton");
+}
@@ -0,0 +1,200 @@
+#pragma once
+// Jakub Staroń, 2016
+
+#include "headers.h"
+#include "numeric.h"
+
+namespace lib {
+
+/**
+ * Hash map with open addressing and linear probing.
+ *
+ * All entries are kept in one array, which size is a power of two,
+ * so lookup touches consecutive memory and insertion doesn't allocate
+ * (except rehashing). Load factor is kept below 1/2. Hash values
+ * are mixed with Fibonacci hashing, so identity std::hash for
+ * integers works well.
+ *
+ * Removal uses backward shift, so no tombstones are left.
+ *
+ * Example:
+ * <pre>
+ * FlatHashMap<uint32, uint32> map(1000);
+ * map.insert(5, 10); // returns true
+ * map.insert(5, 11); // returns false, value is still 10
+ * *map.find(5); // 10
+ * map.find(6); // nullptr
+ * map[6] = 12;
+ * </pre>
+ */
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class FlatHashMap {
+public:
+  using key_type = Key;
+  using mapped_type = Value;
+
+  /**
+   * Creates map which can hold expected_size elements without rehashing.
+   */
+  explicit FlatHashMap(size_t expected_size = 0):
+      size_(0) {
+    rehash(CapacityFor(expected_size));
+  }
+
+  /**
+   * Inserts (key, value) if key is not in map.
+   *
+   * Returns true if value was inserted.
+   */
+  bool insert(const key_type& key, const mapped_type& value) {
+    reserve(size_ + 1);
+    size_t index = position(key);
+    if (slots_[index].used)
+      return false;
+    place(index, key, value);
+    return true;
+  }
+
+  /**
+   * Returns pointer to value associated with key or nullptr
+   * if there is no such key.
+   */
+  mapped_type* find(const key_type& key) {
+    const size_t index = position(key);
+    return slots_[index].used? &slots_[index].value : nullptr;
+  }
+
+  const mapped_type* find(const key_type& key) const {
+    const size_t index = position(key);
+    return slots_[index].used? &slots_[index].value : nullptr;
+  }
+
+  bool contains(const key_type& key) const {
+    return find(key) != nullptr;
+  }
+
+  /**
+   * Returns reference to value associated with key,
+   * inserts default value if there is no such key.
+   */
+  mapped_type& operator[](const key_type& key) {
+    reserve(size_ + 1);
+    size_t index = position(key);
+    if (!slots_[index].used)
+      place(index, key, mapped_type());
+    return slots_[index].value;
+  }
+
+  /**
+   * Removes key from map. Returns true if key was in map.
+   */
+  bool erase(const key_type& key) {
+    size_t hole = position(key);
+    if (!slots_[hole].used)
+      return false;
+
+    for (size_t index = next(hole); slots_[index].used; index = next(index)) {
+      const size_t home = bucket(slots_[index].key);
+      // move entry to hole if hole lies on the way from home to index
+      if (((index - home) & mask_) >= ((index - hole) & mask_)) {
+        slots_[hole] = std::move(slots_[index]);
+        hole = index;
+      }
+    }
+    slots_[hole] = slot();
+    size_--;
+    return true;
+  }
+
+  /**
+   * Makes room for expected_size elements.
+   */
+  void reserve(size_t expected_size) {
+    if (CapacityFor(expected_size) > slots_.size())
+      rehash(CapacityFor(expected_size));
+  }
+
+  void clear() {
+    std::fill(slots_.begin(), slots_.end(), slot());
+    size_ = 0;
+  }
+
+  size_t size() const {
+    return size_;
+  }
+
+  bool empty() const {
+    return size_ == 0;
+  }
+
+  /**
+   * Calls function(key, value) for every element in unspecified order.
+   */
+  template <typename Function>
+  void forEach(Function function) const {
+    for (const auto& entry: slots_)
+      if (entry.used)
+        function(entry.key, entry.value);
+  }
+
+private:
+  struct slot {
+    key_type key;
+    mapped_type value;
+    bool used;
+
+    slot():
+        key(), value(), used(false) { }
+  };
+
+  static size_t CapacityFor(size_t expected_size) {
+    size_t capacity = 16;
+    while (capacity < 2 * expected_size)
+      capacity *= 2;
+    return capacity;
+  }
+
+  size_t bucket(const key_type& key) const {
+    return size_t((uint64(hash_(key)) * 0x9E3779B97F4A7C15uLL) >> shift_);
+  }
+
+  size_t next(size_t index) const {
+    return (index + 1) & mask_;
+  }
+
+  /**
+   * Returns index of slot with key or of empty slot where key should be.
+   */
+  size_t position(const key_type& key) const {
+    size_t index = bucket(key);
+    while (slots_[index].used && !(slots_[index].key == key))
+      index = next(index);
+    return index;
+  }
+
+  void place(size_t index, const key_type& key, const mapped_type& value) {
+    slots_[index].key = key;
+    slots_[index].value = value;
+    slots_[index].used = true;
+    size_++;
+  }
+
+  void rehash(size_t capacity) {
+    std::vector<slot> old_slots(capacity);
+    old_slots.swap(slots_);
+    mask_ = capacity - 1;
+    shift_ = 64 - least_significant_one(capacity);
+    size_ = 0;
+    for (auto& entry: old_slots)
+      if (entry.used)
+        place(position(entry.key), entry.key, entry.value);
+  }
+
+  std::vector<slot> slots_;
+  size_t size_;
+  size_t mask_;
+  uint32 shift_;
+  Hash hash_;
+};
+
+} // namespace lib
@@ -23,7 +23,7 @@ public:
     calculate();
   }
 
-  index_type minimum(index_type first, index_type last) {
+  index_type minimum(index_type first, index_type last) const {
     constexpr const char* kInvalidRange = "RangeMinimumQuery - invalid range!";
     if (first > last)
       throw std::invalid_argument(kInvalidRange);
@@ -41,6 +41,13 @@ public:
     return uint32(values_.size());
   }
 
+  /**
+   * Returns value at index.
+   */
+  reference value(index_type index) const {
+    return values_[index];
+  }
+
 private:
   void calculate() {
     segments_[0].assign(counting_iterator<uint32>(0), counting_iterator<uint32>(size()));
@@ -49,7 +56,7 @@ private:
     {
       const size_type segment_length = (1u << i);
       const size_type segments_count = size() - segment_length + 1;
-      segments_[i].reserve(segments_count);
+      segments_[i].resize(segments_count);
       for (auto j : range<index_type>(0, segments_count))
         segments_[i][j] = minimum_index(i - 1, j, j + segment_length / 2);
     }
@@ -0,0 +1,127 @@
+#pragma once
+// Jakub Staroń, 2016
+
+#include "headers.h"
+#include "numeric.h"
+
+namespace lib {
+
+/**
+ * Static bit vector with constant time rank (number of ones in prefix).
+ *
+ * Bits are stored in blocks of 8 words (one cache line), first word of block
+ * is the number of ones before block and 7 next keep 448 bits, so rank reads
+ * one cache line and takes at most 7 pop counts. Memory is n / 7 bytes.
+ *
+ * Example:
+ * <pre>
+ * std::vector<bool> bits = {1, 0, 1, 1};
+ * RankBitVector vector(bits.begin(), bits.end());
+ * vector.rank(3); // 2
+ * vector[1]; // false
+ * </pre>
+ */
+class RankBitVector {
+public:
+  /**
+   * Builds vector from range of values convertible to bool.
+   */
+  template <typename Iterator>
+  RankBitVector(Iterator begin, Iterator end):
+      size_(0), ones_(0) {
+    const uint64 size = uint64(std::distance(begin, end));
+    if (size >= std::numeric_limits<uint32>::max())
+      throw std::invalid_argument("RankBitVector - too many bits");
+    size_ = uint32(size);
+    // one additional block for rank(size()), words are aligned to cache line
+    blocks_ = size_ / kBitsPerBlock + 1;
+    words_.assign(blocks_ * kBlockWords + kBlockWords, 0);
+    first_ = (kBlockWords - (reinterpret_cast<uintptr_t>(words_.data()) / sizeof(uint64)) % kBlockWords) % kBlockWords;
+
+    uint64* words = words_.data() + first_;
+    for (uint32 i = 0; begin != end; ++begin, ++i)
+      if (*begin)
+        words[(i / kBitsPerBlock) * kBlockWords + 1 + (i % kBitsPerBlock) / 64] |= uint64(1) << (i % 64);
+    for (uint32 block = 0; block < blocks_; block++) {
+      uint64* words_of_block = words + block * kBlockWords;
+      words_of_block[0] = ones_;
+      for (uint32 k = 1; k < kBlockWords; k++)
+        ones_ += pop_count(words_of_block[k]);
+    }
+  }
+
+  /**
+   * Builds empty vector.
+   */
+  RankBitVector():
+      RankBitVector(static_cast<const bool*>(nullptr), static_cast<const bool*>(nullptr)) { }
+
+  RankBitVector(const RankBitVector& other):
+      words_(other.words_.size()),
+      first_(0),
+      blocks_(other.blocks_),
+      size_(other.size_),
+      ones_(other.ones_) {
+    first_ = (kBlockWords - (reinterpret_cast<uintptr_t>(words_.data()) / sizeof(uint64)) % kBlockWords) % kBlockWords;
+    std::copy_n(other.data(), blocks_ * kBlockWords, words_.data() + first_);
+  }
+
+  RankBitVector(RankBitVector&& other) = default;
+  RankBitVector& operator=(const RankBitVector&) = delete;
+  RankBitVector& operator=(RankBitVector&&) = default;
+
+  uint32 size() const {
+    return size_;
+  }
+
+  /**
+   * Returns number of ones.
+   */
+  uint32 ones() const {
+    return ones_;
+  }
+
+  bool operator[](uint32 index) const {
+    const uint64* block = data() + (index / kBitsPerBlock) * kBlockWords;
+    const uint32 offset = index % kBitsPerBlock;
+    return (block[1 + offset / 64] >> (offset % 64)) & 1;
+  }
+
+  /**
+   * Returns number of ones in [0, index), index can be equal to size().
+   */
+  uint32 rank(uint32 index) const {
+    const uint64* block = data() + (index / kBitsPerBlock) * kBlockWords;
+    const uint32 offset = index % kBitsPerBlock;
+    uint64 result = block[0];
+    const uint32 full_words = offset / 64;
+    for (uint32 k = 1; k <= full_words; k++)
+      result += pop_count(block[k]);
+    if (offset % 64 != 0)
+      result += pop_count(block[1 + full_words] & ((uint64(1) << (offset % 64)) - 1));
+    return uint32(result);
+  }
+
+  /**
+   * Returns memory used by vector in bytes.
+   */
+  size_t bytes() const {
+    return words_.size() * sizeof(uint64);
+  }
+
+private:
+  static constexpr uint32 kBlockWords = 8;
+  static constexpr uint32 kBitsPerBlock = 64 * (kBlockWords - 1);
+
+  const uint64* data() const {
+    return words_.data() + first_;
+  }
+
+  std::vector<uint64> words_;
+  size_t first_;
+  uint32 blocks_;
+  uint32 size_;
+  uint32 ones_;
+};
+
+} // namespace lib
@@ -0,0 +1,185 @@
+#pragma once
+// Jakub Staroń, 2016
+
+#include "headers.h"
+#include "data_structures/rank_bit_vector.h"
+
+namespace lib {
+
+/**
+ * Static sequence of values from [0, 2^bits) with access and rank
+ * (number of occurrences of value in prefix) in O(bits) time.
+ *
+ * Level k keeps k-th bit (from the most significant) of values, ordered stably
+ * by their k higher bits read in reverse, in a RankBitVector. Memory is
+ * about bits * n / 7 bytes, plus 4 * 2^bits bytes of table of positions
+ * where values start after the last level (only for bits <= kTableBits),
+ * which saves half of ranks in rank.
+ *
+ * Example:
+ * <pre>
+ * std::vector<uint32> values = {3, 1, 3, 0};
+ * WaveletMatrix matrix(values.begin(), values.end(), 2);
+ * matrix[2]; // 3
+ * matrix.rank(3, 3); // 2
+ * </pre>
+ */
+class WaveletMatrix {
+public:
+  static constexpr uint32 kTableBits = 16;
+
+  /**
+   * Builds matrix of range of integers.
+   *
+   * Throws an std::invalid_argument if bits is not in [1, 32]
+   * or some value is not smaller than 2^bits.
+   */
+  template <typename Iterator>
+  WaveletMatrix(Iterator begin, Iterator end, uint32 bits):
+      bits_(bits) {
+    if (bits == 0 || bits > 32)
+      throw std::invalid_argument("WaveletMatrix - bits must be in [1, 32]");
+    std::vector<uint32> values;
+    values.reserve(std::distance(begin, end));
+    for (; begin != end; ++begin) {
+      const uint64 value = uint64(*begin);
+      if (value >> bits != 0)
+        throw std::invalid_argument("WaveletMatrix - value out of range");
+      values.push_back(uint32(value));
+    }
+    size_ = uint32(values.size());
+
+    std::vector<bool> level_bits(values.size());
+    std::vector<uint32> ones;
+    for (uint32 level = 0; level < bits; level++) {
+      const uint32 shift = bits - 1 - level;
+      // stable partition: zeros first, then ones
+      ones.clear();
+      uint32 zeros = 0;
+      for (uint32 i = 0; i < values.size(); i++) {
+        const bool bit = (values[i] >> shift) & 1;
+        level_bits[i] = bit;
+        if (bit)
+          ones.push_back(values[i]);
+        else
+          values[zeros++] = values[i];
+      }
+      std::copy(ones.begin(), ones.end(), values.begin() + zeros);
+      levels_.emplace_back(level_bits.begin(), level_bits.end());
+      zeros_.push_back(zeros);
+    }
+
+    // after the last level values are sorted by reversed bits
+    if (bits <= kTableBits) {
+      std::vector<uint32> counts(uint32(1) << bits, 0);
+      for (uint32 value: values)
+        counts[value]++;
+      starts_.resize(counts.size());
+      for (uint32 reversed = 0, start = 0; reversed < counts.size(); reversed++) {
+        uint32 value = 0;
+        for (uint32 bit = 0; bit < bits; bit++)
+          value |= ((reversed >> bit) & 1) << (bits - 1 - bit);
+        starts_[value] = start;
+        start += counts[value];
+      }
+    }
+  }
+
+  /**
+   * Builds empty matrix.
+   */
+  WaveletMatrix():
+      WaveletMatrix(static_cast<const uint32*>(nullptr), static_cast<const uint32*>(nullptr), 1) { }
+
+  uint32 size() const {
+    return size_;
+  }
+
+  uint32 bits() const {
+    return bits_;
+  }
+
+  /**
+   * Returns value at index.
+   */
+  uint32 operator[](uint32 index) const {
+    return trace(index);
+  }
+
+  /**
+   * Returns number of occurrences of value in [0, index), index can be equal to size().
+   */
+  uint32 rank(uint32 value, uint32 index) const {
+    if (bits_ < 32 && value >> bits_ != 0)
+      return 0;
+    if (!starts_.empty())
+      return descend(value, index) - starts_[value];
+    return descend(value, index) - descend(value, 0);
+  }
+
+  /**
+   * Returns pair of value at index and number of its occurrences in [0, index),
+   * at cost of one access when table of starts is kept.
+   */
+  std::pair<uint32, uint32> accessRank(uint32 index) const {
+    if (starts_.empty()) {
+      const uint32 value = (*this)[index];
+      return std::make_pair(value, rank(value, index));
+    }
+    const uint32 value = trace(index);
+    return std::make_pair(value, index - starts_[value]);
+  }
+
+  /**
+   * Returns memory used by matrix in bytes.
+   */
+  size_t bytes() const {
+    size_t result = starts_.size() * sizeof(uint32) + zeros_.size() * sizeof(uint32);
+    for (const auto& level: levels_)
+      result += level.bytes();
+    return result;
+  }
+
+private:
+  /**
+   * Returns value at index and moves index to its position after all levels.
+   */
+  uint32 trace(uint32& index) const {
+    uint32 value = 0;
+    for (uint32 level = 0; level < bits_; level++) {
+      const RankBitVector& vector = levels_[level];
+      const uint32 ones = vector.rank(index);
+      if (vector[index]) {
+        value = value << 1 | 1;
+        index = zeros_[level] + ones;
+      }
+      else {
+        value <<= 1;
+        index -= ones;
+      }
+    }
+    return value;
+  }
+
+  /**
+   * Returns position of index after all levels, following bits of value.
+   */
+  uint32 descend(uint32 value, uint32 index) const {
+    for (uint32 level = 0; level < bits_; level++) {
+      const uint32 ones = levels_[level].rank(index);
+      if ((value >> (bits_ - 1 - level)) & 1)
+        index = zeros_[level] + ones;
+      else
+        index -= ones;
+    }
+    return index;
+  }
+
+  uint32 bits_;
+  uint32 size_;
+  std::vector<RankBitVector> levels_;
+  std::vector<uint32> zeros_;
+  std::vector<uint32> starts_;
+};
+
+} // namespace lib
@@ -13,7 +13,8 @@ using namespace lib;
 constexpr uint32 kPrime = 1000 * 1000 * 1000 + 7;
 constexpr uint32 kMaxN = 50 * 1000;
 
-auto primes = numeric::PrimeNumbers(kMaxN + 1);
+const numeric::LinearSieve sieve(kMaxN + 1);
+const auto& primes = sieve.primes();
 using result_type = numeric::prime_field<kPrime>;
 
 
@@ -11,7 +11,8 @@ using namespace lib;
 
 const uint64 kMaxN = power(10uLL, 18);
 const uint64 kPrimesToPreprocess = power(10uLL, 6);
-auto primes = numeric::PrimeNumbers(kPrimesToPreprocess);
+const numeric::LinearSieve sieve(kPrimesToPreprocess);
+const auto& primes = sieve.primes();
 
 uint64 NumberOfDivisors(uint64 N) {
   std::vector<uint32> counts;
@@ -35,7 +36,7 @@ uint64 NumberOfDivisors(uint64 N) {
       counts.push_back(1);
     }
     else {
-      uint64 sqrt = numeric::SquareFloor(N);
+      uint64 sqrt = SquareFloor(N);
       if (sqrt * sqrt == N) {
         counts.push_back(2);
       }
@@ -49,19 +49,456 @@ inline constexpr hash_type subtract(const hash_type& lhs, const hash_type& rhs)
   return lhs - rhs;
 }
 
+namespace detail {
+
+constexpr size_t kHashBlockSize = 1024;
+
+/**
+ * Returns sum of values[i] * power * base^i and multiplies power by base^count.
+ *
+ * Splits sequence into 4 lanes sharing one power, so multiplications
+ * of consecutive elements don't depend on each other.
+ */
+template <typename Backend>
+typename Backend::hash_type AccumulateHash(const scalar_type* values, size_t count,
+                                           typename Backend::hash_type& power) {
+  using hash_type = typename Backend::hash_type;
+  constexpr size_t kLanes = 4;
+  const hash_type base = Backend::base();
+  const hash_type step = Backend::multiply(Backend::multiply(base, base), Backend::multiply(base, base));
+
+  hash_type sums[kLanes] = {Backend::zero(), Backend::zero(), Backend::zero(), Backend::zero()};
+  hash_type lane_power = Backend::one();
+  size_t i = 0;
+  for (; i + kLanes <= count; i += kLanes) {
+    for (size_t j = 0; j < kLanes; j++)
+      sums[j] = Backend::add(sums[j], Backend::multiply(lane_power, values[i + j]));
+    lane_power = Backend::multiply(lane_power, step);
+  }
+
+  hash_type result = Backend::zero();
+  hash_type offset = power;
+  for (size_t j = 0; j < kLanes; j++) {
+    result = Backend::add(result, Backend::multiply(sums[j], offset));
+    offset = Backend::multiply(offset, base);
+  }
+  power = Backend::multiply(power, lane_power);
+  for (; i < count; i++) {
+    result = Backend::add(result, Backend::multiply(power, values[i]));
+    power = Backend::multiply(power, base);
+  }
+  return result;
+}
+
+/**
+ * Computes Horner scheme prefix hashes result[i] = result[i - 1] * base + values[i],
+ * where result[-1] = start. powers[t] must be base^t for t <= kHornerBlock.
+ *
+ * Elements are processed in blocks: h[s + t] = h[s] * base^t + local_t,
+ * where local_t is hash of block prefix and doesn't depend on h[s],
+ * so chain of dependent multiplications is shorter.
+ */
+constexpr size_t kHornerBlock = 8;
+
+template <typename Backend>
+void HornerHash(const scalar_type* values, size_t count, typename Backend::hash_type start,
+                const typename Backend::hash_type* powers, typename Backend::hash_type* result) {
+  using hash_type = typename Backend::hash_type;
+  const hash_type base = Backend::base();
+  for (size_t block = 0; block < count; block += kHornerBlock) {
+    hash_type local = Backend::zero();
+    for (size_t t = 1; t <= kHornerBlock && block + t <= count; t++) {
+      local = Backend::add(Backend::multiply(local, base), Backend::scalar(values[block + t - 1]));
+      result[block + t - 1] = Backend::add(Backend::multiply(start, powers[t]), local);
+    }
+    start = result[std::min(count, block + kHornerBlock) - 1];
+  }
+}
+
+/**
+ * Returns lhs * rhs (mod 2^61 - 1), lhs and rhs must be smaller than 2^61.
+ */
+inline uint64 MultiplyMersenne61(uint64 lhs, uint64 rhs) {
+  constexpr uint64 kModulo = (1uLL << 61) - 1;
+#ifdef USE_INT128_TYPES
+  const uint128 product = uint128(lhs) * uint128(rhs);
+  const uint64 reduced = (uint64(product) & kModulo) + uint64(product >> 61);
+#else
+  // lhs = lhs_high 2^31 + lhs_low, 2^62 = 2 (mod kModulo)
+  const uint64 lhs_high = lhs >> 31, lhs_low = lhs & ((1u << 31) - 1);
+  const uint64 rhs_high = rhs >> 31, rhs_low = rhs & ((1u << 31) - 1);
+  const uint64 middle = lhs_low * rhs_high + lhs_high * rhs_low;
+  const uint64 sum = ((lhs_high * rhs_high) << 1) + (middle >> 30) +
+      ((middle & ((1u << 30) - 1)) << 31) + lhs_low * rhs_low;
+  const uint64 reduced = (sum & kModulo) + (sum >> 61);
+#endif
+  return (reduced >= kModulo)? reduced - kModulo : reduced;
+}
+
+#ifdef HAVE_X86_INTRINSICS
+
+inline bool CpuSupportsAvx2() {
+  static const bool result = __builtin_cpu_supports("avx2");
+  return result;
+}
+
+/**
+ * Returns lanes of power * values (mod 2^61 - 1) reduced below 2^61 + 8.
+ *
+ * power lanes must be smaller than 2^61, values lanes smaller than 2^32.
+ * power = high 2^32 + low, high * value * 2^32 = (t >> 29) 2^61 + (t mod 2^29) 2^32
+ * and 2^61 = 1.
+ */
+__attribute__((target("avx2")))
+inline __m256i MultiplyMersenne61Avx2(__m256i power, __m256i values) {
+  const __m256i modulo = _mm256_set1_epi64x((1uLL << 61) - 1);
+  const __m256i low = _mm256_mul_epu32(power, values);
+  const __m256i high = _mm256_mul_epu32(_mm256_srli_epi64(power, 32), values);
+  const __m256i high_reduced = _mm256_add_epi64(
+      _mm256_srli_epi64(high, 29),
+      _mm256_slli_epi64(_mm256_and_si256(high, _mm256_set1_epi64x((1 << 29) - 1)), 32));
+  const __m256i low_reduced = _mm256_add_epi64(_mm256_and_si256(low, modulo), _mm256_srli_epi64(low, 61));
+  const __m256i sum = _mm256_add_epi64(high_reduced, low_reduced);
+  return _mm256_add_epi64(_mm256_and_si256(sum, modulo), _mm256_srli_epi64(sum, 61));
+}
+
+/**
+ * Returns lanes smaller than 2^63 reduced modulo 2^61 - 1.
+ */
+__attribute__((target("avx2")))
+inline __m256i ReduceMersenne61Avx2(__m256i value) {
+  const __m256i modulo = _mm256_set1_epi64x((1uLL << 61) - 1);
+  value = _mm256_add_epi64(_mm256_and_si256(value, modulo), _mm256_srli_epi64(value, 61));
+  const __m256i too_big = _mm256_cmpgt_epi64(value, _mm256_sub_epi64(modulo, _mm256_set1_epi64x(1)));
+  return _mm256_sub_epi64(value, _mm256_and_si256(too_big, modulo));
+}
+
+__attribute__((target("avx2")))
+inline __m256i LoadScalarsAvx2(const scalar_type* values) {
+  return _mm256_cvtepu32_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(values)));
+}
+
+/**
+ * Computes result[i] = powers[i] * values[i] (mod 2^61 - 1), 4 elements per step.
+ */
+__attribute__((target("avx2")))
+inline size_t MultiplyAllMersenne61Avx2(const uint64* powers, const scalar_type* values,
+                                        uint64* result, size_t count) {
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    const __m256i power = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(powers + i));
+    const __m256i product = MultiplyMersenne61Avx2(power, LoadScalarsAvx2(values + i));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(result + i), ReduceMersenne61Avx2(product));
+  }
+  return i;
+}
+
+/**
+ * Accumulates values[i] * base^i (mod 2^61 - 1) in 8 lanes,
+ * lane j of sums gets elements with index j (mod 8).
+ * Returns number of processed elements, lane_power becomes base^processed.
+ */
+__attribute__((target("avx2")))
+inline size_t AccumulateMersenne61Avx2(const scalar_type* values, size_t count, uint64 step,
+                                       uint64& lane_power, uint64* sums) {
+  const __m256i modulo = _mm256_set1_epi64x((1uLL << 61) - 1);
+  __m256i low_sums = _mm256_setzero_si256();
+  __m256i high_sums = _mm256_setzero_si256();
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    // lane_power is multiplied in scalar unit, lanes of sums don't depend on it
+    const __m256i power = _mm256_set1_epi64x(lane_power);
+    low_sums = _mm256_add_epi64(low_sums, MultiplyMersenne61Avx2(power, LoadScalarsAvx2(values + i)));
+    high_sums = _mm256_add_epi64(high_sums, MultiplyMersenne61Avx2(power, LoadScalarsAvx2(values + i + 4)));
+    // sums are kept below 2^61 + 2
+    low_sums = _mm256_add_epi64(_mm256_and_si256(low_sums, modulo), _mm256_srli_epi64(low_sums, 61));
+    high_sums = _mm256_add_epi64(_mm256_and_si256(high_sums, modulo), _mm256_srli_epi64(high_sums, 61));
+    lane_power = MultiplyMersenne61(lane_power, step);
+  }
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(sums), ReduceMersenne61Avx2(low_sums));
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(sums + 4), ReduceMersenne61Avx2(high_sums));
+  return i;
+}
+
+/**
+ * Returns lanes of lhs * rhs (mod 2^61 - 1) reduced below 2^61 + 8,
+ * lanes of lhs and rhs must be smaller than 2^62.
+ */
+__attribute__((target("avx2")))
+inline __m256i MultiplyFullMersenne61Avx2(__m256i lhs, __m256i rhs) {
+  const __m256i modulo = _mm256_set1_epi64x((1uLL << 61) - 1);
+  const __m256i lhs_high = _mm256_srli_epi64(lhs, 32);
+  const __m256i rhs_high = _mm256_srli_epi64(rhs, 32);
+  const __m256i low = _mm256_mul_epu32(lhs, rhs);
+  const __m256i middle = _mm256_add_epi64(_mm256_mul_epu32(lhs, rhs_high), _mm256_mul_epu32(lhs_high, rhs));
+  const __m256i high = _mm256_mul_epu32(lhs_high, rhs_high);
+  // 2^64 = 8, 2^61 = 1
+  __m256i sum = _mm256_slli_epi64(high, 3);
+  sum = _mm256_add_epi64(sum, _mm256_srli_epi64(middle, 29));
+  sum = _mm256_add_epi64(sum, _mm256_slli_epi64(_mm256_and_si256(middle, _mm256_set1_epi64x((1 << 29) - 1)), 32));
+  sum = _mm256_add_epi64(sum, _mm256_and_si256(low, modulo));
+  sum = _mm256_add_epi64(sum, _mm256_srli_epi64(low, 61));
+  return _mm256_add_epi64(_mm256_and_si256(sum, modulo), _mm256_srli_epi64(sum, 61));
+}
+
+/**
+ * Horner scheme prefix hashes (see HornerHash) in 4 AVX2 lanes.
+ *
+ * Sequence is split into 4 segments, lanes compute hashes of segment
+ * prefixes in parallel, then every segment is shifted by hash
+ * preceding it, 4 elements per step using powers of base.
+ * Returns number of processed elements.
+ */
+__attribute__((target("avx2")))
+inline size_t HornerMersenne61Avx2(const scalar_type* values, size_t count, uint64 start,
+                                   const uint64* powers, uint64* result) {
+  const size_t segment = count / 4 / 4 * 4;
+  if (segment == 0)
+    return 0;
+
+  const __m256i base = _mm256_set1_epi64x(powers[1]);
+  __m256i local = _mm256_setzero_si256();
+  alignas(32) uint64 lanes[4];
+  for (size_t t = 0; t < segment; t++) {
+    const __m256i scalars = _mm256_setr_epi64x(
+        values[t], values[segment + t], values[2 * segment + t], values[3 * segment + t]);
+    local = _mm256_add_epi64(MultiplyFullMersenne61Avx2(local, base), scalars);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), ReduceMersenne61Avx2(local));
+    for (size_t lane = 0; lane < 4; lane++)
+      result[lane * segment + t] = lanes[lane];
+  }
+
+  for (size_t lane = 0; lane < 4; lane++) {
+    uint64* lane_result = result + lane * segment;
+    const __m256i shift = _mm256_set1_epi64x(start);
+    for (size_t t = 0; t < segment; t += 4) {
+      const __m256i power = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(powers + t + 1));
+      const __m256i value = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lane_result + t));
+      const __m256i shifted = _mm256_add_epi64(value, MultiplyFullMersenne61Avx2(shift, power));
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(lane_result + t), ReduceMersenne61Avx2(shifted));
+    }
+    start = lane_result[segment - 1];
+  }
+  return 4 * segment;
+}
+
+#endif
+
+} // namespace detail
+
+/**
+ * Hash backend with pair of 32 bits primes, ie functions above.
+ *
+ * Backend is a type with static functions zero, one, base, scalar, add,
+ * subtract, multiply and inverse over its hash_type, and bulk functions
+ * accumulate, multiplyAll and horner used by hash::hash and Hasher.
+ */
+struct prime_pair {
+  using hash_type = hash::hash_type;
+
+  static constexpr hash_type zero() {
+    return hash::zero;
+  }
+
+  static constexpr hash_type one() {
+    return hash::one;
+  }
+
+  static constexpr hash_type base() {
+    return hash::multipler;
+  }
+
+  static constexpr hash_type scalar(scalar_type value) {
+    return {value, value};
+  }
+
+  static constexpr hash_type add(const hash_type& lhs, const hash_type& rhs) {
+    return hash::add(lhs, rhs);
+  }
+
+  static constexpr hash_type subtract(const hash_type& lhs, const hash_type& rhs) {
+    return hash::subtract(lhs, rhs);
+  }
+
+  static constexpr hash_type multiply(const hash_type& lhs, const hash_type& rhs) {
+    return hash::multiply(lhs, rhs);
+  }
+
+  static constexpr hash_type multiply(const hash_type& lhs, scalar_type rhs) {
+    return hash::multiply(lhs, rhs);
+  }
+
+  static hash_type inverse(const hash_type& hash) {
+    return {numeric::inverse(hash.first), numeric::inverse(hash.second)};
+  }
+
+  /**
+   * Returns sum of values[i] * power * base^i and multiplies power by base^count.
+   */
+  static hash_type accumulate(const scalar_type* values, size_t count, hash_type& power) {
+    return detail::AccumulateHash<prime_pair>(values, count, power);
+  }
+
+  /**
+   * Computes result[i] = powers[i] * values[i].
+   */
+  static void multiplyAll(const hash_type* powers, const scalar_type* values, hash_type* result, size_t count) {
+    for (size_t i = 0; i < count; i++)
+      result[i] = multiply(powers[i], values[i]);
+  }
+
+  /**
+   * Computes Horner scheme prefix hashes starting from start,
+   * powers[t] must be base^t for t <= max(count, detail::kHornerBlock).
+   */
+  static void horner(const scalar_type* values, size_t count, hash_type start,
+                     const hash_type* powers, hash_type* result) {
+    detail::HornerHash<prime_pair>(values, count, start, powers, result);
+  }
+};
+
+/**
+ * Hash backend modulo Mersenne prime 2^61 - 1.
+ *
+ * Hash is a single 64 bits word and reduction uses only
+ * shifts and additions. Base is chosen randomly at startup,
+ * so hashes are not reproducible between runs.
+ */
+struct mersenne61 {
+  using hash_type = uint64;
+
+  static constexpr uint64 kModulo = (1uLL << 61) - 1;
+
+  static constexpr hash_type zero() {
+    return 0;
+  }
+
+  static constexpr hash_type one() {
+    return 1;
+  }
+
+  static hash_type base() {
+    static const hash_type base = (1u << 20) + Random64() % (kModulo - (1u << 20));
+    return base;
+  }
+
+  static constexpr hash_type scalar(scalar_type value) {
+    return value;
+  }
+
+  static constexpr hash_type add(hash_type lhs, hash_type rhs) {
+    return reduce(lhs + rhs);
+  }
+
+  static constexpr hash_type subtract(hash_type lhs, hash_type rhs) {
+    return (lhs >= rhs)? lhs - rhs : lhs + kModulo - rhs;
+  }
+
+  static hash_type multiply(hash_type lhs, hash_type rhs) {
+    return detail::MultiplyMersenne61(lhs, rhs);
+  }
+
+  static hash_type multiply(hash_type lhs, scalar_type rhs) {
+    return multiply(lhs, scalar(rhs));
+  }
+
+  static hash_type inverse(hash_type hash) {
+    hash_type result = one();
+    for (uint64 n = kModulo - 2; n > 0; n /= 2) {
+      if (n % 2 == 1)
+        result = multiply(result, hash);
+      hash = multiply(hash, hash);
+    }
+    return result;
+  }
+
+  /**
+   * Returns sum of values[i] * power * base^i and multiplies power by base^count.
+   *
+   * Uses 8 AVX2 lanes if processor supports them.
+   */
+  static hash_type accumulate(const scalar_type* values, size_t count, hash_type& power) {
+#ifdef HAVE_X86_INTRINSICS
+    if (detail::CpuSupportsAvx2() && count >= 8) {
+      hash_type step = base();
+      for (int i = 0; i < 3; i++)
+        step = multiply(step, step);
+      hash_type lane_power = one();
+      hash_type sums[8];
+      const size_t processed = detail::AccumulateMersenne61Avx2(values, count, step, lane_power, sums);
+
+      hash_type result = zero();
+      hash_type offset = power;
+      for (auto sum: sums) {
+        result = add(result, multiply(sum, offset));
+        offset = multiply(offset, base());
+      }
+      power = multiply(power, lane_power);
+      return add(result, detail::AccumulateHash<mersenne61>(values + processed, count - processed, power));
+    }
+#endif
+    return detail::AccumulateHash<mersenne61>(values, count, power);
+  }
+
+  /**
+   * Computes result[i] = powers[i] * values[i].
+   *
+   * Uses AVX2 if processor supports it.
+   */
+  static void multiplyAll(const hash_type* powers, const scalar_type* values, hash_type* result, size_t count) {
+    size_t i = 0;
+#ifdef HAVE_X86_INTRINSICS
+    if (detail::CpuSupportsAvx2())
+      i = detail::MultiplyAllMersenne61Avx2(powers, values, result, count);
+#endif
+    for (; i < count; i++)
+      result[i] = multiply(powers[i], values[i]);
+  }
+
+  /**
+   * Computes Horner scheme prefix hashes starting from start,
+   * powers[t] must be base^t for t <= max(count, detail::kHornerBlock).
+   *
+   * Uses AVX2 if processor supports it.
+   */
+  static void horner(const scalar_type* values, size_t count, hash_type start,
+                     const hash_type* powers, hash_type* result) {
+    size_t i = 0;
+#ifdef HAVE_X86_INTRINSICS
+    if (detail::CpuSupportsAvx2()) {
+      i = detail::HornerMersenne61Avx2(values, count, start, powers, result);
+      if (i > 0)
+        start = result[i - 1];
+    }
+#endif
+    detail::HornerHash<mersenne61>(values + i, count - i, start, powers, result + i);
+  }
+
+private:
+  static constexpr hash_type reduce(hash_type value) {
+    return (value >= kModulo)? value - kModulo : value;
+  }
+};
+
 /**
  * Computes hash of sequence.
  *
- * It's guaranteed that hash of empty sequence is equal to hash::zero.
+ * Elements are converted to scalar_type in blocks,
+ * which are hashed with Backend::accumulate.
+ *
+ * It's guaranteed that hash of empty sequence is equal to Backend::zero().
  */
-template <typename Iterator>
-hash_type hash(Iterator begin, Iterator end) {
-  hash_type result = zero;
-  hash_type power = one;
-  for (auto c: make_range(begin, end)) {
-    hash_type m = multiply(power, scalar_type(c));
-    result = add(result, m);
-    power = multiply(power, multipler);
+template <typename Backend = prime_pair, typename Iterator>
+typename Backend::hash_type hash(Iterator begin, Iterator end) {
+  using hash_type = typename Backend::hash_type;
+  hash_type result = Backend::zero();
+  hash_type power = Backend::one();
+  scalar_type block[detail::kHashBlockSize];
+  while (begin != end) {
+    size_t count = 0;
+    for (; count < detail::kHashBlockSize && begin != end; ++begin)
+      block[count++] = scalar_type(*begin);
+    result = Backend::add(result, Backend::accumulate(block, count, power));
   }
   return result;
 }
@@ -69,15 +506,17 @@ hash_type hash(Iterator begin, Iterator end) {
 /**
  * Computes hash of string.
  */
-hash_type hash(const std::string& text) {
-  return hash(text.begin(), text.end());
+template <typename Backend = prime_pair>
+typename Backend::hash_type hash(const std::string& text) {
+  return hash<Backend>(text.begin(), text.end());
 }
 
 /**
  * Computes hash of C-string.
  */
-hash_type hash(const char* text) {
-  return hash(text, text + std::strlen(text));
+template <typename Backend = prime_pair>
+typename Backend::hash_type hash(const char* text) {
+  return hash<Backend>(text, text + std::strlen(text));
 }
 
 } // namespace hash
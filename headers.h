@@ -3,6 +3,7 @@
 
 #include <iostream>
 #include <sstream>
+#include <fstream>
 #include <iterator>
 #include <type_traits>
 #include <algorithm>
@@ -23,8 +24,25 @@
 #include <ctime>
 #include <cctype>
 #include <cstring>
+#include <cmath>
+#include <cstdio>
+#include <cerrno>
 #include <random>
 #include <cassert>
+#include <limits>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define HAVE_X86_INTRINSICS
+#include <immintrin.h>
+#endif
 
 namespace lib {
 
@@ -5,6 +5,80 @@
 
 namespace lib {
 
+/**
+ * Non-owning view of sequence of characters.
+ *
+ * Viewed characters must outlive string_ref.
+ */
+class string_ref {
+public:
+  using iterator = const char*;
+  using const_iterator = const char*;
+
+  string_ref():
+      data_(nullptr), size_(0) { }
+
+  string_ref(const char* data, size_t size):
+      data_(data), size_(size) { }
+
+  /**
+   * Views null-terminated string, eg string literal.
+   */
+  string_ref(const char* text):
+      data_(text), size_(std::strlen(text)) { }
+
+  string_ref(const std::string& text):
+      data_(text.data()), size_(text.size()) { }
+
+  /**
+   * Temporary string would be destroyed before the view is used.
+   */
+  string_ref(std::string&&) = delete;
+
+  const char* data() const {
+    return data_;
+  }
+
+  size_t size() const {
+    return size_;
+  }
+
+  bool empty() const {
+    return size_ == 0;
+  }
+
+  const_iterator begin() const {
+    return data_;
+  }
+
+  const_iterator end() const {
+    return data_ + size_;
+  }
+
+  char operator[](size_t index) const {
+    return data_[index];
+  }
+
+  /**
+   * Returns copy of viewed characters.
+   */
+  std::string str() const {
+    return std::string(data_, size_);
+  }
+
+  friend bool operator==(const string_ref& lhs, const string_ref& rhs) {
+    return lhs.size_ == rhs.size_ && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+  }
+
+  friend std::ostream& operator<<(std::ostream& stream, const string_ref& text) {
+    return stream.write(text.data_, text.size_);
+  }
+
+private:
+  const char* data_;
+  size_t size_;
+};
+
 namespace detail {
 
 const int kSimpleFancyFlagID = std::ios_base::xalloc();
@@ -20,6 +94,9 @@ public:
     fancy_ = (stream.iword(kSimpleFancyFlagID) == fancy_printing_type);
   }
 
+  delimiter_printer(printing_type type):
+      first_(true), fancy_(type == fancy_printing_type) { }
+
   const char* prefix() {
     return fancy_? "(" : "";
   }
@@ -43,11 +120,21 @@ private:
   bool fancy_;
 };
 
+template <typename T>
+constexpr bool is_character() {
+  return
+      std::is_same<T, char>::value ||
+      std::is_same<T, signed char>::value ||
+      std::is_same<T, unsigned char>::value ||
+      std::is_same<T, bool>::value;
+}
+
 template <typename T>
 constexpr bool allow_print_operator() {
   return
       is_iterable<T>::value &&
       !std::is_same<T, std::string>::value &&
+      !std::is_same<T, string_ref>::value &&
       !std::is_same<T, const char*>::value &&
       !std::is_same<typename std::remove_extent<T>::type, char>::value;
 }
@@ -138,6 +225,448 @@ std::ostream& operator<<(std::ostream& stream, int128 n) {
 
 #endif
 
+/**
+ * Buffered reader parsing input directly from file descriptor.
+ *
+ * Reads input in big blocks into own buffer and parses integers
+ * and whitespace-separated tokens straight from it, without locales
+ * and virtual calls. Can be used instead of std::istream with
+ * read, ReadSequence and ignore.
+ *
+ * If value can not be read, reader is marked as failed and
+ * value is left unchanged.
+ *
+ * Example:
+ * <pre>
+ * FastReader reader; // reads from standard input
+ * int a;
+ * std::string s;
+ * reader >> a >> s;
+ * </pre>
+ */
+class FastReader {
+public:
+  static constexpr size_t kBufferSize = 1 << 16;
+
+  /**
+   * Constructs reader reading from given file descriptor.
+   *
+   * Reader doesn't take ownership of descriptor.
+   */
+  explicit FastReader(int descriptor = STDIN_FILENO):
+      descriptor_(descriptor),
+      buffer_(new char[kBufferSize]),
+      position_(buffer_.get()),
+      end_(buffer_.get()),
+      eof_(false),
+      fail_(false) { }
+
+  FastReader(const FastReader&) = delete;
+  FastReader& operator=(const FastReader&) = delete;
+
+  /**
+   * Reads integral number, optionally preceded by whitespaces.
+   */
+  template <typename Integral>
+  typename std::enable_if<std::is_integral<Integral>::value && !detail::is_character<Integral>(), FastReader&>::type
+  operator>>(Integral& value) {
+    using unsigned_type = typename std::make_unsigned<Integral>::type;
+    if (!skipWhitespaces())
+      return fail();
+
+    bool negative = false;
+    if (std::is_signed<Integral>::value && *position_ == '-') {
+      negative = true;
+      ++position_;
+    }
+
+    if (!isdigit(peek()))
+      return fail();
+
+    unsigned_type result = readDigits<unsigned_type>();
+    value = Integral(negative ? unsigned_type(-result) : result);
+    return *this;
+  }
+
+  /**
+   * Reads single non-whitespace character.
+   */
+  FastReader& operator>>(char& value) {
+    if (!skipWhitespaces())
+      return fail();
+    value = *position_++;
+    return *this;
+  }
+
+  /**
+   * Reads whitespace-separated token.
+   */
+  FastReader& operator>>(std::string& value) {
+    if (!skipWhitespaces())
+      return fail();
+
+    value.clear();
+    do {
+      const char* begin = position_;
+      while (position_ != end_ && !isspace(*position_))
+        ++position_;
+      value.append(begin, position_);
+    } while (position_ == end_ && refill());
+    return *this;
+  }
+
+  /**
+   * Returns next character without extracting it or EOF if
+   * there is no more input.
+   */
+  int peek() {
+    if (position_ == end_ && !refill())
+      return EOF;
+    return byte(*position_);
+  }
+
+  /**
+   * Returns true if end of input was reached.
+   */
+  bool eof() const {
+    return eof_ && position_ == end_;
+  }
+
+  /**
+   * Returns true if no read failed so far.
+   */
+  explicit operator bool() const {
+    return !fail_;
+  }
+
+private:
+  static bool isdigit(int c) {
+    return uint32(c - '0') < 10u;
+  }
+
+  static bool isspace(char c) {
+    return byte(c) <= byte(' ');
+  }
+
+  bool refill() {
+    if (eof_)
+      return false;
+
+    ssize_t count;
+    do {
+      count = ::read(descriptor_, buffer_.get(), kBufferSize);
+    } while (count < 0 && errno == EINTR);
+
+    if (count <= 0) {
+      eof_ = true;
+      count = 0;
+    }
+    position_ = buffer_.get();
+    end_ = position_ + count;
+    return count > 0;
+  }
+
+  bool skipWhitespaces() {
+    do {
+      while (position_ != end_ && isspace(*position_))
+        ++position_;
+    } while (position_ == end_ && refill());
+    return position_ != end_;
+  }
+
+  template <typename Unsigned>
+  Unsigned readDigits() {
+    Unsigned result = 0;
+    do {
+      while (position_ != end_) {
+        const uint32 digit = uint32(*position_ - '0');
+        if (digit >= 10u)
+          return result;
+        result = result * 10u + digit;
+        ++position_;
+      }
+    } while (refill());
+    return result;
+  }
+
+  FastReader& fail() {
+    fail_ = true;
+    return *this;
+  }
+
+  int descriptor_;
+  std::unique_ptr<char[]> buffer_;
+  const char* position_;
+  const char* end_;
+  bool eof_;
+  bool fail_;
+};
+
+constexpr size_t FastReader::kBufferSize;
+
+/**
+ * Buffered writer formatting output directly into own buffer.
+ *
+ * Buffer is written to file descriptor when it's full, on flush
+ * and on destruction (errors of the last write are ignored there,
+ * call flush to detect them). Integers are converted to text two digits
+ * at a time, floating point numbers are written like by std::ostream
+ * with default precision. Supports simple and fancy printing modes,
+ * newline and flush manipulators, and printing of pairs, tuples
+ * and iterables.
+ *
+ * Example:
+ * <pre>
+ * FastWriter writer; // writes to standard output
+ * writer << fancy << std::make_pair(1, 2) << newline;
+ * </pre>
+ */
+class FastWriter {
+public:
+  static constexpr size_t kBufferSize = 1 << 16;
+
+  /**
+   * Constructs writer writing to given file descriptor.
+   *
+   * Writer doesn't take ownership of descriptor.
+   */
+  explicit FastWriter(int descriptor = STDOUT_FILENO):
+      descriptor_(descriptor),
+      buffer_(new char[kBufferSize]),
+      position_(buffer_.get()),
+      printing_type_(detail::simple_printing_type) { }
+
+  FastWriter(const FastWriter&) = delete;
+  FastWriter& operator=(const FastWriter&) = delete;
+
+  ~FastWriter() {
+    try {
+      flush();
+    }
+    catch (...) {
+    }
+  }
+
+  /**
+   * Writes single character.
+   */
+  FastWriter& put(char c) {
+    if (position_ == buffer_.get() + kBufferSize)
+      flush();
+    *position_++ = c;
+    return *this;
+  }
+
+  /**
+   * Writes size characters starting from data.
+   */
+  FastWriter& write(const char* data, size_t size) {
+    if (size > available()) {
+      flush();
+      if (size > kBufferSize) {
+        writeAll(data, size);
+        return *this;
+      }
+    }
+    std::memcpy(position_, data, size);
+    position_ += size;
+    return *this;
+  }
+
+  /**
+   * Writes buffered data to file descriptor.
+   */
+  FastWriter& flush() {
+    writeAll(buffer_.get(), size_t(position_ - buffer_.get()));
+    position_ = buffer_.get();
+    return *this;
+  }
+
+  /**
+   * Writes integral number in decimal notation.
+   */
+  template <typename Integral>
+  typename std::enable_if<std::is_integral<Integral>::value && !detail::is_character<Integral>(), FastWriter&>::type
+  operator<<(Integral value) {
+    using unsigned_type = typename std::make_unsigned<Integral>::type;
+    constexpr size_t kMaxLength = std::numeric_limits<unsigned_type>::digits10 + 2;
+    if (available() < kMaxLength)
+      flush();
+
+    unsigned_type absolute = value;
+    if (value < 0) {
+      *position_++ = '-';
+      absolute = unsigned_type(-absolute);
+    }
+    position_ = formatUnsigned(absolute, position_);
+    return *this;
+  }
+
+  /**
+   * Writes floating point number in %g notation with 6 significant digits,
+   * the same as default formatting of std::ostream.
+   */
+  template <typename Floating>
+  typename std::enable_if<std::is_floating_point<Floating>::value, FastWriter&>::type
+  operator<<(Floating value) {
+    char digits[32];
+    const int length = std::snprintf(digits, sizeof(digits), "%Lg", static_cast<long double>(value));
+    return write(digits, size_t(length));
+  }
+
+#ifdef USE_INT128_TYPES
+
+  /**
+   * Writes uint128 number in decimal notation.
+   */
+  FastWriter& operator<<(uint128 value) {
+    constexpr uint64 kTenToNineteen = 10000000000000000000uLL;
+    if (value <= std::numeric_limits<uint64>::max())
+      return *this << uint64(value);
+
+    *this << (value / kTenToNineteen);
+    char digits[32];
+    char* end = formatUnsigned(uint64(value % kTenToNineteen), digits);
+    const size_t length = size_t(end - digits);
+    for (size_t i = length; i < 19; ++i)
+      put('0');
+    return write(digits, length);
+  }
+
+  /**
+   * Writes int128 number in decimal notation.
+   */
+  FastWriter& operator<<(int128 value) {
+    if (value < 0) {
+      put('-');
+      return *this << uint128(-uint128(value));
+    }
+    return *this << uint128(value);
+  }
+
+#endif
+
+  template <typename Bool>
+  typename std::enable_if<std::is_same<Bool, bool>::value, FastWriter&>::type
+  operator<<(Bool value) {
+    return put(value ? '1' : '0');
+  }
+
+  FastWriter& operator<<(char c) {
+    return put(c);
+  }
+
+  FastWriter& operator<<(const char* text) {
+    return write(text, std::strlen(text));
+  }
+
+  FastWriter& operator<<(const std::string& text) {
+    return write(text.data(), text.size());
+  }
+
+  FastWriter& operator<<(const string_ref& text) {
+    return write(text.data(), text.size());
+  }
+
+  /**
+   * Applies one of manipulators simple, fancy, newline, flush or std::endl.
+   *
+   * Throws std::invalid_argument for other manipulators.
+   */
+  FastWriter& operator<<(std::ostream& (*manipulator)(std::ostream&));
+
+  /**
+   * Returns current printing mode (simple or fancy).
+   */
+  detail::printing_type printing() const {
+    return printing_type_;
+  }
+
+private:
+  size_t available() const {
+    return size_t(buffer_.get() + kBufferSize - position_);
+  }
+
+  void writeAll(const char* data, size_t size) {
+    while (size > 0) {
+      ssize_t count = ::write(descriptor_, data, size);
+      if (count < 0) {
+        if (errno == EINTR)
+          continue;
+        throw std::ios::failure("FastWriter - write failed.");
+      }
+      data += count;
+      size -= size_t(count);
+    }
+  }
+
+  /**
+   * Writes value at output, returns pointer past the last written digit.
+   */
+  template <typename Unsigned>
+  static char* formatUnsigned(Unsigned number, char* output) {
+    using value_type = typename std::conditional<(sizeof(Unsigned) <= sizeof(uint32)), uint32, uint64>::type;
+    static constexpr char kDigitPairs[] =
+        "00010203040506070809"
+        "10111213141516171819"
+        "20212223242526272829"
+        "30313233343536373839"
+        "40414243444546474849"
+        "50515253545556575859"
+        "60616263646566676869"
+        "70717273747576777879"
+        "80818283848586878889"
+        "90919293949596979899";
+
+    value_type value = number;
+    char digits[24];
+    char* begin = digits + sizeof(digits);
+    while (value >= 100) {
+      const uint32 pair = uint32(value % 100) * 2;
+      value /= 100;
+      *--begin = kDigitPairs[pair + 1];
+      *--begin = kDigitPairs[pair];
+    }
+    if (value >= 10) {
+      const uint32 pair = uint32(value) * 2;
+      *--begin = kDigitPairs[pair + 1];
+      *--begin = kDigitPairs[pair];
+    }
+    else {
+      *--begin = char('0' + value);
+    }
+    const size_t length = size_t(digits + sizeof(digits) - begin);
+    std::memcpy(output, begin, length);
+    return output + length;
+  }
+
+  int descriptor_;
+  std::unique_ptr<char[]> buffer_;
+  char* position_;
+  detail::printing_type printing_type_;
+};
+
+constexpr size_t FastWriter::kBufferSize;
+
+/**
+ * Overload operator<< for FastWriter and pair.
+ */
+template <typename T1, typename T2>
+FastWriter& operator<<(FastWriter& writer, const std::pair<T1, T2>& pair);
+
+/**
+ * Overload operator<< for FastWriter and tuple.
+ */
+template <typename... Args>
+FastWriter& operator<<(FastWriter& writer, const std::tuple<Args...>& tuple);
+
+/**
+ * Overload operator<< for FastWriter and every iterable (eg vector, map, array).
+ */
+template <typename Iterable>
+typename std::enable_if<detail::allow_print_operator<Iterable>(), FastWriter&>::type
+operator<<(FastWriter& writer, const Iterable& iterable);
+
 /**
  * Overload operator<< for istream and pair.
  */
@@ -150,6 +679,18 @@ std::istream& operator>>(std::istream& stream, std::pair<T1, T2>& pair);
 template <typename... Args>
 std::istream& operator>>(std::istream& stream, std::tuple<Args...>& tuple);
 
+/**
+ * Overload operator>> for FastReader and pair.
+ */
+template <typename T1, typename T2>
+FastReader& operator>>(FastReader& reader, std::pair<T1, T2>& pair);
+
+/**
+ * Overload operator>> for FastReader and tuple.
+ */
+template <typename... Args>
+FastReader& operator>>(FastReader& reader, std::tuple<Args...>& tuple);
+
 /**
  * Helper for marking input as ignored.
  *
@@ -172,6 +713,16 @@ struct ignore {
     T ignored;
     return stream >> ignored;
   }
+
+  friend FastReader& operator>>(FastReader& reader, const ignore&&) {
+    T ignored;
+    return reader >> ignored;
+  }
+
+  friend FastReader& operator>>(FastReader& reader, const ignore&) {
+    T ignored;
+    return reader >> ignored;
+  }
 };
 
 namespace detail {
@@ -228,13 +779,13 @@ private:
 template <typename Functor, size_t N>
 constexpr typename dynamize<Functor, N>::table_type dynamize<Functor, N>::functions_;
 
-template <typename... Args>
+template <typename Stream, typename... Args>
 class tuple_printer {
   static constexpr size_t arguments_count = sizeof...(Args);
   using tuple_type = std::tuple<Args...>;
 
   struct impl {
-    std::ostream& stream_;
+    Stream& stream_;
     const tuple_type& tuple_;
 
     template <size_t N>
@@ -244,7 +795,7 @@ class tuple_printer {
   };
 
 public:
-  tuple_printer (std::ostream& stream, const tuple_type& tuple):
+  tuple_printer (Stream& stream, const tuple_type& tuple):
     dynamize_(impl{stream, tuple}) { }
 
   void print(size_t i) {
@@ -255,13 +806,13 @@ private:
   dynamize<impl, arguments_count> dynamize_;
 };
 
-template <typename... Args>
+template <typename Stream, typename... Args>
 class tuple_reader {
   static constexpr size_t arguments_count = sizeof...(Args);
   using tuple_type = std::tuple<Args...>;
 
   struct impl {
-    std::istream& stream_;
+    Stream& stream_;
     tuple_type& tuple_;
 
     template <size_t N>
@@ -271,7 +822,7 @@ class tuple_reader {
   };
 
 public:
-  tuple_reader (std::istream& stream, tuple_type& tuple):
+  tuple_reader (Stream& stream, tuple_type& tuple):
       dynamize_(impl{stream, tuple}) { }
 
   void read(size_t i) {
@@ -297,7 +848,7 @@ std::ostream& operator<<(std::ostream& stream, const std::pair<T1, T2>& pair) {
 template <typename... Args>
 std::ostream& operator<<(std::ostream& stream, const std::tuple<Args...>& tuple) {
   detail::delimiter_printer delimiter_printer(stream);
-  detail::tuple_printer<Args...> tuple_printer(stream, tuple);
+  detail::tuple_printer<std::ostream, Args...> tuple_printer(stream, tuple);
   stream << delimiter_printer.prefix();
   for (auto i: range<size_t>(0, sizeof...(Args))) {
     stream << delimiter_printer.delimiter();
@@ -319,6 +870,41 @@ operator<<(std::ostream& stream, const Iterable& iterable) {
   return stream;
 }
 
+template <typename T1, typename T2>
+FastWriter& operator<<(FastWriter& writer, const std::pair<T1, T2>& pair) {
+  detail::delimiter_printer printer(writer.printing());
+  writer << printer.prefix();
+  writer << printer.delimiter() << pair.first;
+  writer << printer.delimiter() << pair.second;
+  writer << printer.postfix();
+  return writer;
+}
+
+template <typename... Args>
+FastWriter& operator<<(FastWriter& writer, const std::tuple<Args...>& tuple) {
+  detail::delimiter_printer delimiter_printer(writer.printing());
+  detail::tuple_printer<FastWriter, Args...> tuple_printer(writer, tuple);
+  writer << delimiter_printer.prefix();
+  for (auto i: range<size_t>(0, sizeof...(Args))) {
+    writer << delimiter_printer.delimiter();
+    tuple_printer.print(i);
+  }
+  writer << delimiter_printer.postfix();
+  return writer;
+}
+
+template <typename Iterable>
+typename std::enable_if<detail::allow_print_operator<Iterable>(), FastWriter&>::type
+operator<<(FastWriter& writer, const Iterable& iterable) {
+  detail::delimiter_printer printer(writer.printing());
+  writer << printer.prefix();
+  for (const auto& elem: iterable) {
+    writer << printer.delimiter() << elem;
+  }
+  writer << printer.postfix();
+  return writer;
+}
+
 template <typename T1, typename T2>
 std::istream& operator>>(std::istream& stream, std::pair<T1, T2>& pair) {
   return stream >> pair.first >> pair.second;
@@ -326,13 +912,27 @@ std::istream& operator>>(std::istream& stream, std::pair<T1, T2>& pair) {
 
 template <typename... Args>
 std::istream& operator>>(std::istream& stream, std::tuple<Args...>& tuple) {
-  detail::tuple_reader<Args...> tuple_reader(stream, tuple);
+  detail::tuple_reader<std::istream, Args...> tuple_reader(stream, tuple);
   for (auto i: range<size_t>(0, sizeof...(Args))) {
     tuple_reader.read(i);
   }
   return stream;
 }
 
+template <typename T1, typename T2>
+FastReader& operator>>(FastReader& reader, std::pair<T1, T2>& pair) {
+  return reader >> pair.first >> pair.second;
+}
+
+template <typename... Args>
+FastReader& operator>>(FastReader& reader, std::tuple<Args...>& tuple) {
+  detail::tuple_reader<FastReader, Args...> tuple_reader(reader, tuple);
+  for (auto i: range<size_t>(0, sizeof...(Args))) {
+    tuple_reader.read(i);
+  }
+  return reader;
+}
+
 
 /**
  * Second version of overload operator>> for istream and pair.
@@ -349,17 +949,19 @@ std::istream& operator>>(std::istream& stream, std::tuple<Args...>&& tuple) {
 }
 
 /**
- * Python-like print function.
- *
- * Example:
- * <pre>
- * print(std::cerr, "1 + 2 = %0, 2 + 3 = %1", 3, 5);
- * </pre>
+ * Overload operator>> for FastReader and rvalue tuple.
  */
 template <typename... Args>
-void print(std::ostream& stream, const char* format, const Args&... args) {
+FastReader& operator>>(FastReader& reader, std::tuple<Args...>&& tuple) {
+  return reader >> tuple;
+}
+
+namespace detail {
+
+template <typename Stream, typename... Args>
+void print(Stream& stream, const char* format, const Args&... args) {
   auto tuple = std::make_tuple(std::cref(args)...);
-  detail::tuple_printer<const Args&...> tuple_printer(stream, tuple);
+  detail::tuple_printer<Stream, const Args&...> tuple_printer(stream, tuple);
   constexpr char null = '\0';
   constexpr char percent = '%';
   for (const char* it = format, *prev = format; *it != '\0'; ) {
@@ -385,6 +987,29 @@ void print(std::ostream& stream, const char* format, const Args&... args) {
   stream.put('\n');
 }
 
+} // namespace detail
+
+/**
+ * Python-like print function.
+ *
+ * Example:
+ * <pre>
+ * print(std::cerr, "1 + 2 = %0, 2 + 3 = %1", 3, 5);
+ * </pre>
+ */
+template <typename... Args>
+void print(std::ostream& stream, const char* format, const Args&... args) {
+  detail::print(stream, format, args...);
+}
+
+/**
+ * Python-like print function. Prints to FastWriter.
+ */
+template <typename... Args>
+void print(FastWriter& writer, const char* format, const Args&... args) {
+  detail::print(writer, format, args...);
+}
+
 /**
  * Python-like print function. Prints to std::cout.
  */
@@ -393,6 +1018,200 @@ void print(const char* format, const Args&... args) {
   print(std::cout, format, args...);
 }
 
+namespace detail {
+
+template <typename... T>
+struct always_false: std::false_type { };
+
+template <char... Chars>
+struct format_literal {
+  static constexpr char data[] = {Chars...};
+
+  template <typename Stream, typename Tuple>
+  static void print(Stream& stream, const Tuple&) {
+    stream.write(data, sizeof...(Chars));
+  }
+};
+
+template <char... Chars>
+constexpr char format_literal<Chars...>::data[];
+
+template <>
+struct format_literal<> {
+  template <typename Stream, typename Tuple>
+  static void print(Stream&, const Tuple&) { }
+};
+
+template <size_t Index>
+struct format_argument {
+  template <typename Stream, typename Tuple>
+  static void print(Stream& stream, const Tuple& tuple) {
+    static_assert(Index < std::tuple_size<Tuple>::value, "print - argument index out of range");
+    stream << std::get<Index>(tuple);
+  }
+};
+
+template <typename... Pieces>
+struct format_pieces {
+  template <typename Stream, typename Tuple>
+  static void print(Stream& stream, const Tuple& tuple) {
+    int expander[] = {0, (Pieces::print(stream, tuple), 0)...};
+    (void)expander;
+  }
+};
+
+/**
+ * Splits format into sequence of literals and arguments.
+ * Pieces are already parsed parts, Literal is the current literal.
+ */
+template <typename Pieces, typename Literal, char... Chars>
+struct format_parser;
+
+template <typename... Pieces, char... Literal>
+struct format_parser<format_pieces<Pieces...>, format_literal<Literal...>> {
+  using type = format_pieces<Pieces..., format_literal<Literal...>>;
+};
+
+template <typename... Pieces, char... Literal, char C, char... Chars>
+struct format_parser<format_pieces<Pieces...>, format_literal<Literal...>, C, Chars...> {
+  using type = typename format_parser<
+      format_pieces<Pieces...>,
+      format_literal<Literal..., C>,
+      Chars...>::type;
+};
+
+template <typename... Pieces, char... Literal, char... Chars>
+struct format_parser<format_pieces<Pieces...>, format_literal<Literal...>, '%', '%', Chars...> {
+  using type = typename format_parser<
+      format_pieces<Pieces...>,
+      format_literal<Literal..., '%'>,
+      Chars...>::type;
+};
+
+template <typename... Pieces, char... Literal, char C, char... Chars>
+struct format_parser<format_pieces<Pieces...>, format_literal<Literal...>, '%', C, Chars...> {
+  static_assert('0' <= C && C <= '9', "print - invalid character after %");
+  using type = typename format_parser<
+      format_pieces<Pieces..., format_literal<Literal...>, format_argument<size_t(C - '0')>>,
+      format_literal<>,
+      Chars...>::type;
+};
+
+template <typename... Pieces, char... Literal>
+struct format_parser<format_pieces<Pieces...>, format_literal<Literal...>, '%'> {
+  static_assert(always_false<Pieces...>::value, "print - format can't end with %");
+  using type = format_pieces<>;
+};
+
+template <char... Chars>
+struct format_string {
+  using pieces = typename format_parser<format_pieces<>, format_literal<>, Chars...>::type;
+};
+
+template <typename Stream, char... Chars, typename... Args>
+void print(Stream& stream, format_string<Chars...>, const Args&... args) {
+  using pieces = typename format_string<Chars...>::pieces;
+  pieces::print(stream, std::forward_as_tuple(args...));
+  stream.put('\n');
+}
+
+} // namespace detail
+
+namespace detail {
+
+constexpr size_t kMaxFormatLength = 128;
+
+template <size_t N>
+constexpr char format_char(const char (&literal)[N], size_t index) {
+  return (index < N)? literal[index] : '\0';
+}
+
+/**
+ * Builds format_string from first Length characters.
+ */
+template <bool Done, size_t Length, typename Taken, char... Chars>
+struct format_take {
+  static_assert(Done, "LIB_FORMAT - format is too long");
+  using type = Taken;
+};
+
+template <size_t Length, typename Taken, char... Chars>
+struct format_take<true, Length, Taken, Chars...> {
+  using type = Taken;
+};
+
+template <size_t Length, char... Taken, char C, char... Chars>
+struct format_take<false, Length, format_string<Taken...>, C, Chars...> {
+  using type = typename format_take<
+      Length == 1,
+      Length - 1,
+      format_string<Taken..., C>,
+      Chars...>::type;
+};
+
+} // namespace detail
+
+#define LIB_FORMAT_CHARS_8(literal, i) \
+  ::lib::detail::format_char(literal, i + 0), ::lib::detail::format_char(literal, i + 1), \
+  ::lib::detail::format_char(literal, i + 2), ::lib::detail::format_char(literal, i + 3), \
+  ::lib::detail::format_char(literal, i + 4), ::lib::detail::format_char(literal, i + 5), \
+  ::lib::detail::format_char(literal, i + 6), ::lib::detail::format_char(literal, i + 7)
+
+#define LIB_FORMAT_CHARS_32(literal, i) \
+  LIB_FORMAT_CHARS_8(literal, i + 0), LIB_FORMAT_CHARS_8(literal, i + 8), \
+  LIB_FORMAT_CHARS_8(literal, i + 16), LIB_FORMAT_CHARS_8(literal, i + 24)
+
+#define LIB_FORMAT_CHARS_128(literal) \
+  LIB_FORMAT_CHARS_32(literal, 0), LIB_FORMAT_CHARS_32(literal, 32), \
+  LIB_FORMAT_CHARS_32(literal, 64), LIB_FORMAT_CHARS_32(literal, 96)
+
+/**
+ * Format parsed at compile time. Argument must be string literal
+ * not longer than detail::kMaxFormatLength characters.
+ *
+ * Format is split into literal chunks and arguments during
+ * compilation, so printing is a sequence of writes without
+ * scanning and dispatching. Invalid % sequences and
+ * out of range arguments are compilation errors.
+ *
+ * Example:
+ * <pre>
+ * print(std::cerr, LIB_FORMAT("1 + 2 = %0, 2 + 3 = %1"), 3, 5);
+ * </pre>
+ */
+#define LIB_FORMAT(literal) \
+  ::lib::detail::format_take< \
+      sizeof(literal) == 1, \
+      sizeof(literal) - 1, \
+      ::lib::detail::format_string<>, \
+      LIB_FORMAT_CHARS_128(literal)>::type()
+
+/**
+ * Python-like print function with compile-time parsed format.
+ */
+template <char... Chars, typename... Args>
+void print(std::ostream& stream, detail::format_string<Chars...> format, const Args&... args) {
+  detail::print(stream, format, args...);
+}
+
+/**
+ * Python-like print function with compile-time parsed format.
+ * Prints to FastWriter.
+ */
+template <char... Chars, typename... Args>
+void print(FastWriter& writer, detail::format_string<Chars...> format, const Args&... args) {
+  detail::print(writer, format, args...);
+}
+
+/**
+ * Python-like print function with compile-time parsed format.
+ * Prints to std::cout.
+ */
+template <char... Chars, typename... Args>
+void print(detail::format_string<Chars...> format, const Args&... args) {
+  print(std::cout, format, args...);
+}
+
 /**
  * flush operator for usage with print.
  *
@@ -417,6 +1236,23 @@ std::ostream& newline(std::ostream& stream) {
   return stream.put('\n');
 }
 
+FastWriter& FastWriter::operator<<(std::ostream& (*manipulator)(std::ostream&)) {
+  using manipulator_type = std::ostream& (*)(std::ostream&);
+  if (manipulator == manipulator_type(simple))
+    printing_type_ = detail::simple_printing_type;
+  else if (manipulator == manipulator_type(fancy))
+    printing_type_ = detail::fancy_printing_type;
+  else if (manipulator == manipulator_type(newline))
+    put('\n');
+  else if (manipulator == manipulator_type(lib::flush) || manipulator == manipulator_type(std::flush))
+    flush();
+  else if (manipulator == manipulator_type(std::endl))
+    put('\n').flush();
+  else
+    throw std::invalid_argument("FastWriter - unsupported manipulator");
+  return *this;
+}
+
 /**
  * Python-like read function.
  *
@@ -432,6 +1268,22 @@ void read(std::istream& stream, Args&&... args) {
   stream >> tuple;
 }
 
+/**
+ * Python-like read function. Reads from FastReader.
+ *
+ * Example:
+ * <pre>
+ * FastReader reader;
+ * int a, b;
+ * read(reader, a, ignore<int>(), b);
+ * </pre>
+ */
+template <typename... Args>
+void read(FastReader& reader, Args&&... args) {
+  auto tuple = std::make_tuple(std::ref(args)...);
+  reader >> tuple;
+}
+
 /**
  * Generator for reading lines from std::istream.
  */
@@ -475,6 +1327,174 @@ iterator_range<lines_iterator> iterate_lines(std::istream& stream) {
   return make_range(lines_iterator(&stream), lines_iterator());
 }
 
+/**
+ * Read-only memory mapping of whole file.
+ *
+ * Kernel is advised that file will be read sequentially.
+ * Throws std::ios::failure if file can't be mapped.
+ *
+ * Example:
+ * <pre>
+ * MappedFile file("input.txt");
+ * std::count(file.data(), file.data() + file.size(), '\n');
+ * </pre>
+ */
+class MappedFile {
+public:
+  /**
+   * Maps file with given path.
+   */
+  explicit MappedFile(const std::string& path):
+      data_(kEmpty), size_(0) {
+    int descriptor = ::open(path.c_str(), O_RDONLY);
+    if (descriptor < 0)
+      throw std::ios::failure("MappedFile - can't open " + path);
+    try {
+      map(descriptor);
+    }
+    catch (...) {
+      ::close(descriptor);
+      throw;
+    }
+    ::close(descriptor);
+  }
+
+  /**
+   * Maps file with given descriptor.
+   *
+   * Doesn't take ownership of descriptor.
+   */
+  explicit MappedFile(int descriptor):
+      data_(kEmpty), size_(0) {
+    map(descriptor);
+  }
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  MappedFile(MappedFile&& other):
+      data_(other.data_), size_(other.size_) {
+    other.data_ = kEmpty;
+    other.size_ = 0;
+  }
+
+  ~MappedFile() {
+    if (size_ > 0)
+      ::munmap(const_cast<char*>(data_), size_);
+  }
+
+  const char* data() const {
+    return data_;
+  }
+
+  size_t size() const {
+    return size_;
+  }
+
+private:
+  void map(int descriptor) {
+    struct stat status;
+    if (::fstat(descriptor, &status) != 0)
+      throw std::ios::failure("MappedFile - can't stat file.");
+
+    size_ = size_t(status.st_size);
+    if (size_ == 0)
+      return;
+
+    void* address = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    if (address == MAP_FAILED) {
+      size_ = 0;
+      throw std::ios::failure("MappedFile - mmap failed.");
+    }
+    ::madvise(address, size_, MADV_SEQUENTIAL);
+    data_ = static_cast<const char*>(address);
+  }
+
+  static constexpr const char* kEmpty = "";
+
+  const char* data_;
+  size_t size_;
+};
+
+constexpr const char* MappedFile::kEmpty;
+
+/**
+ * Forward iterator over lines of memory buffer.
+ *
+ * Lines are returned as string_ref pointing into buffer, without
+ * trailing newline character. Behaves like lines_iterator, ie
+ * buffer "Ala\n" consists of two lines: "Ala" and "".
+ */
+class mapped_lines_iterator {
+public:
+  using self_type = mapped_lines_iterator;
+  using value_type = string_ref;
+  using reference = const value_type&;
+  using pointer = const value_type*;
+  using difference_type = std::ptrdiff_t;
+  using iterator_category = std::forward_iterator_tag;
+
+  mapped_lines_iterator():
+      line_(), end_(nullptr) { }
+
+  mapped_lines_iterator(const char* begin, const char* end):
+      end_(end) {
+    setLine(begin);
+  }
+
+  reference operator*() const {
+    return line_;
+  }
+
+  pointer operator->() const {
+    return &line_;
+  }
+
+  self_type& operator++() {
+    const char* line_end = line_.end();
+    if (line_end == end_) {
+      line_ = string_ref();
+      end_ = nullptr;
+    }
+    else {
+      setLine(line_end + 1);
+    }
+    return *this;
+  }
+
+  friend bool operator==(const self_type& lhs, const self_type& rhs) {
+    return lhs.line_.data() == rhs.line_.data() && lhs.end_ == rhs.end_;
+  }
+
+private:
+  void setLine(const char* begin) {
+    const void* newline = std::memchr(begin, '\n', size_t(end_ - begin));
+    const char* line_end = (newline != nullptr)? static_cast<const char*>(newline) : end_;
+    line_ = string_ref(begin, size_t(line_end - begin));
+  }
+
+  string_ref line_;
+  const char* end_;
+};
+
+/**
+ * Returns range of mapped_lines_iterator to iterate over all lines
+ * in memory mapped file. Doesn't allocate memory per line.
+ *
+ * Example:
+ * <pre>
+ * MappedFile file("input.txt");
+ * for (string_ref line: iterate_lines(file)) {
+ *   ...
+ * }
+ * </pre>
+ */
+iterator_range<mapped_lines_iterator> iterate_lines(const MappedFile& file) {
+  const char* begin = file.data();
+  const char* end = begin + file.size();
+  return make_range(mapped_lines_iterator(begin, end), mapped_lines_iterator());
+}
+
 /**
  * Helper class for reading elements to container from stream.
  *
@@ -501,6 +1521,13 @@ struct SequenceReader {
     return stream;
   }
 
+  friend FastReader& operator>>(FastReader& stream, SequenceReader reader) {
+    reader.container_.resize(reader.count_);
+    for (auto& elem: reader.container_)
+      stream >> elem;
+    return stream;
+  }
+
 private:
   size_type count_;
   container_type& container_;
@@ -0,0 +1,109 @@
+#pragma once
+// Jakub Staroń, 2016
+
+#include "headers.h"
+#include "numeric/prime_field.h"
+
+namespace lib {
+namespace numeric {
+
+/**
+ * Precomputed factorials, inverse factorials and inverses
+ * of numbers 1..n in Z_prime.
+ *
+ * Construction is O(n) and uses only one exponentiation,
+ * inverses are computed with recurrence
+ * 1/i = -(prime / i) * 1/(prime mod i).
+ * Binomial coefficients are then served in O(1).
+ *
+ * Note that n must be smaller than prime.
+ *
+ * Example:
+ * <pre>
+ * Combinatorics<1000 * 1000 * 1000 + 7> combinatorics(1000);
+ * combinatorics.binomial(5, 2); // 10
+ * combinatorics.factorial(10); // 3628800
+ * combinatorics.inverse(2) * 2; // 1
+ * </pre>
+ */
+template <uint32 prime>
+class Combinatorics {
+public:
+  using field = prime_field<prime>;
+
+  explicit Combinatorics(uint32 n):
+      factorials_(size_t(n) + 1),
+      inverse_factorials_(size_t(n) + 1),
+      inverses_(size_t(n) + 1) {
+    if (n >= prime)
+      throw std::invalid_argument("Combinatorics - n must be smaller than prime");
+
+    factorials_[0] = 1;
+    inverse_factorials_[0] = 1;
+    if (n >= 1)
+      inverses_[1] = 1;
+    for (uint32 i = 2; i <= n; i++)
+      inverses_[i] = field(prime - prime / i) * inverses_[prime % i];
+
+    for (uint32 i = 1; i <= n; i++) {
+      factorials_[i] = factorials_[i - 1] * i;
+      inverse_factorials_[i] = inverse_factorials_[i - 1] * inverses_[i];
+    }
+  }
+
+  /**
+   * Returns the largest n for which values are precomputed.
+   */
+  uint32 size() const {
+    return uint32(factorials_.size() - 1);
+  }
+
+  /**
+   * Returns n!, n must be not greater than size().
+   */
+  field factorial(uint32 n) const {
+    return factorials_[n];
+  }
+
+  /**
+   * Returns 1/n!, n must be not greater than size().
+   */
+  field inverseFactorial(uint32 n) const {
+    return inverse_factorials_[n];
+  }
+
+  /**
+   * Returns 1/n, n must be positive and not greater than size().
+   */
+  field inverse(uint32 n) const {
+    return inverses_[n];
+  }
+
+  /**
+   * Returns n choose k, which is 0 for k > n.
+   * n must be not greater than size().
+   */
+  field binomial(uint32 n, uint32 k) const {
+    if (k > n)
+      return 0;
+    return factorials_[n] * inverse_factorials_[k] * inverse_factorials_[n - k];
+  }
+
+  /**
+   * Returns number of k-permutations of n, ie n! / (n - k)!.
+   * n must be not greater than size().
+   */
+  field permutations(uint32 n, uint32 k) const {
+    if (k > n)
+      return 0;
+    return factorials_[n] * inverse_factorials_[n - k];
+  }
+
+private:
+  std::vector<field> factorials_;
+  std::vector<field> inverse_factorials_;
+  std::vector<field> inverses_;
+};
+
+} // namespace numeric
+} // namespace lib
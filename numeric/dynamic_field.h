@@ -0,0 +1,214 @@
+#pragma once
+// Jakub Staroń, 2016
+
+#include "headers.h"
+#include "numeric/montgomery_field.h"
+
+namespace lib {
+namespace numeric {
+
+// Predeclarations
+
+template <typename Tag>
+class dynamic_field;
+
+/**
+ * Returns a^n in Z_prime.
+ */
+template <typename Tag>
+dynamic_field<Tag> power(dynamic_field<Tag> a, uint64 n);
+
+/**
+ * Returns 1/lhs in Z_prime.
+ *
+ * Throws an std::runtime_error if lhs is not inversible (ie is 0).
+ */
+template <typename Tag>
+dynamic_field<Tag> inverse(const dynamic_field<Tag>& lhs);
+
+template <typename Tag>
+std::ostream& operator<<(std::ostream& stream, const dynamic_field<Tag>& lhs);
+
+template <typename Tag>
+std::istream& operator>>(std::istream& stream, dynamic_field<Tag>& lhs);
+
+// Predeclarations End
+
+/**
+ * Integers modulo odd prime chosen at runtime, kept in Montgomery form.
+ *
+ * Has the same interface as prime_field. The prime is shared by
+ * all values with the same Tag and is set with setPrime, which
+ * precomputes constants for Montgomery reduction, so multiplication
+ * doesn't use division. Use different tags to work with
+ * several primes at once.
+ *
+ * Values created before the last call to setPrime are invalid.
+ *
+ * Example:
+ * <pre>
+ * using field = dynamic_field<>;
+ * field::setPrime(p); // p read from input
+ * field a = 5;
+ * power(a, 10) / a;
+ * </pre>
+ */
+template <typename Tag = void>
+class dynamic_field {
+  struct raw_tag { };
+
+  dynamic_field(uint32 raw, raw_tag):
+      value_(raw) { }
+
+  static uint32 reduce(uint64 value) {
+    return detail::montgomery_reduce(value, prime_, inverse_);
+  }
+
+public:
+  /**
+   * Sets prime for all dynamic_field<Tag> values.
+   *
+   * Throws an std::invalid_argument if prime is even or smaller than 3.
+   */
+  static void setPrime(uint32 prime) {
+    if (prime < 3)
+      throw std::invalid_argument("dynamic_field - prime must be at least 3");
+    if (prime % 2 == 0)
+      throw std::invalid_argument("dynamic_field - prime must be odd");
+    prime_ = prime;
+    inverse_ = detail::montgomery_inverse(prime);
+    r2_ = (uint64(0) - uint64(prime)) % uint64(prime);
+  }
+
+  static uint32 prime() {
+    return prime_;
+  }
+
+  dynamic_field():
+      value_(0) { }
+
+  template <typename Integral, typename = typename std::enable_if<std::is_integral<Integral>::value>::type>
+  dynamic_field(Integral value):
+      value_(reduce(uint64(detail::modulo(value, prime_)) * r2_)) { }
+
+  friend dynamic_field operator+(const dynamic_field& lhs, const dynamic_field& rhs) {
+    return dynamic_field(detail::montgomery_subtract(lhs.value_, prime_ - rhs.value_, prime_), raw_tag());
+  }
+
+  friend dynamic_field operator-(const dynamic_field& lhs, const dynamic_field& rhs) {
+    return dynamic_field(detail::montgomery_subtract(lhs.value_, rhs.value_, prime_), raw_tag());
+  }
+
+  friend dynamic_field operator*(const dynamic_field& lhs, const dynamic_field& rhs) {
+    return dynamic_field(reduce(uint64(lhs.value_) * uint64(rhs.value_)), raw_tag());
+  }
+
+  friend dynamic_field power <>(dynamic_field a, uint64 n);
+  friend dynamic_field inverse <>(const dynamic_field& lhs);
+
+  /**
+   * Returns lhs/rhs in Z_prime.
+   */
+  friend dynamic_field operator/(const dynamic_field& lhs, const dynamic_field& rhs) {
+    return lhs * inverse(rhs);
+  }
+
+  void operator+=(const dynamic_field& rhs);
+  void operator-=(const dynamic_field& rhs);
+  void operator*=(const dynamic_field& rhs);
+  void operator/=(const dynamic_field& rhs);
+
+  friend bool operator==(const dynamic_field& lhs, const dynamic_field& rhs) {
+    return lhs.value_ == rhs.value_;
+  }
+
+  friend bool operator!=(const dynamic_field& lhs, const dynamic_field& rhs) {
+    return !(lhs == rhs);
+  }
+
+  /**
+   * Returns conversion of value to uint32.
+   */
+  uint32 value() const {
+    return reduce(value_);
+  }
+
+  friend std::ostream& operator<< <>(std::ostream& stream, const dynamic_field& lhs);
+  friend std::istream& operator>> <>(std::istream& stream, dynamic_field& lhs);
+
+private:
+  static uint32 prime_;
+  static uint32 inverse_;
+  static uint32 r2_; // 2^64 (mod prime)
+
+  uint32 value_;
+};
+
+template <typename Tag>
+uint32 dynamic_field<Tag>::prime_ = 1;
+
+template <typename Tag>
+uint32 dynamic_field<Tag>::inverse_ = 1;
+
+template <typename Tag>
+uint32 dynamic_field<Tag>::r2_ = 0;
+
+template <typename Tag>
+dynamic_field<Tag> power(dynamic_field<Tag> a, uint64 n) {
+  if (n == 0)
+    return 1;
+  else if (a == 0)
+    return 0;
+  n %= (dynamic_field<Tag>::prime() - 1); // Fermat little theorem
+  dynamic_field<Tag> result = 1;
+  while (n > 0) {
+    if (n % 2 == 1)
+      result *= a;
+    a *= a;
+    n /= 2;
+  }
+  return result;
+}
+
+template <typename Tag>
+dynamic_field<Tag> inverse(const dynamic_field<Tag>& lhs) {
+  if (lhs == 0)
+    throw std::runtime_error("dynamic_field - inverse of zero");
+  return power(lhs, dynamic_field<Tag>::prime() - 2);
+}
+
+template <typename Tag>
+void dynamic_field<Tag>::operator+=(const dynamic_field<Tag>& rhs) {
+  *this = *this + rhs;
+}
+
+template <typename Tag>
+void dynamic_field<Tag>::operator-=(const dynamic_field<Tag>& rhs) {
+  *this = *this - rhs;
+}
+
+template <typename Tag>
+void dynamic_field<Tag>::operator*=(const dynamic_field<Tag>& rhs) {
+  *this = *this * rhs;
+}
+
+template <typename Tag>
+void dynamic_field<Tag>::operator/=(const dynamic_field<Tag>& rhs) {
+  *this = *this / rhs;
+}
+
+template <typename Tag>
+std::ostream& operator<<(std::ostream& stream, const dynamic_field<Tag>& lhs) {
+  return stream << lhs.value();
+}
+
+template <typename Tag>
+std::istream& operator>>(std::istream& stream, dynamic_field<Tag>& lhs) {
+  int64 value;
+  stream >> value;
+  lhs = dynamic_field<Tag>(value);
+  return stream;
+}
+
+} // namespace numeric
+} // namespace lib
@@ -0,0 +1,379 @@
+#pragma once
+// Jakub Staroń, 2016
+
+#include "headers.h"
+#include "numeric.h"
+#include "numeric/prime_field.h"
+#include "numeric/montgomery_field.h"
+#include "numeric/dynamic_field.h"
+
+namespace lib {
+namespace numeric {
+
+namespace detail {
+
+constexpr size_t kMatrixBlockSize = 64;
+
+template <typename T>
+struct is_modular_field : std::false_type { };
+
+template <uint32 prime>
+struct is_modular_field<prime_field<prime>> : std::true_type { };
+
+template <uint32 prime>
+struct is_modular_field<montgomery_field<prime>> : std::true_type { };
+
+template <typename Tag>
+struct is_modular_field<dynamic_field<Tag>> : std::true_type { };
+
+/**
+ * Returns modulo of field type, works the same way for
+ * compile-time and runtime primes.
+ */
+template <typename Field>
+uint64 FieldModulo() {
+  return uint64((Field(0) - Field(1)).value()) + 1;
+}
+
+} // namespace detail
+
+/**
+ * Dense matrix kept in one row-major array.
+ *
+ * Multiplication is tiled and works on transposed right hand side,
+ * so the innermost loop reads both operands sequentially.
+ * For prime_field, montgomery_field and dynamic_field products
+ * are accumulated in uint64 and reduced once per as many terms
+ * as fit without overflow (18 for primes near 10^9).
+ *
+ * Example:
+ * <pre>
+ * using field = prime_field<1000 * 1000 * 1000 + 7>;
+ * Matrix<field> fibonacci = {{1, 1}, {1, 0}};
+ * power(fibonacci, 100)(0, 1); // 100th Fibonacci number modulo 10^9 + 7
+ * </pre>
+ */
+template <typename T>
+class Matrix {
+public:
+  using value_type = T;
+
+  Matrix():
+      rows_(0), columns_(0) { }
+
+  /**
+   * Creates rows x columns matrix filled with T().
+   */
+  Matrix(size_t rows, size_t columns):
+      rows_(rows), columns_(columns), data_(rows * columns) { }
+
+  Matrix(std::initializer_list<std::initializer_list<T>> rows):
+      rows_(rows.size()), columns_(rows.size() == 0? 0 : rows.begin()->size()) {
+    data_.reserve(rows_ * columns_);
+    for (const auto& row: rows) {
+      if (row.size() != columns_)
+        throw std::invalid_argument("Matrix - rows of different length");
+      data_.insert(data_.end(), row.begin(), row.end());
+    }
+  }
+
+  static Matrix Identity(size_t size) {
+    Matrix result(size, size);
+    for (size_t i = 0; i < size; i++)
+      result(i, i) = 1;
+    return result;
+  }
+
+  size_t rows() const {
+    return rows_;
+  }
+
+  size_t columns() const {
+    return columns_;
+  }
+
+  T& operator()(size_t row, size_t column) {
+    return data_[row * columns_ + column];
+  }
+
+  const T& operator()(size_t row, size_t column) const {
+    return data_[row * columns_ + column];
+  }
+
+  Matrix transposed() const {
+    Matrix result(columns_, rows_);
+    for (size_t i = 0; i < rows_; i++)
+      for (size_t j = 0; j < columns_; j++)
+        result(j, i) = (*this)(i, j);
+    return result;
+  }
+
+  friend Matrix operator+(const Matrix& lhs, const Matrix& rhs) {
+    CheckSameSize(lhs, rhs);
+    Matrix result = lhs;
+    for (size_t i = 0; i < result.data_.size(); i++)
+      result.data_[i] += rhs.data_[i];
+    return result;
+  }
+
+  friend Matrix operator-(const Matrix& lhs, const Matrix& rhs) {
+    CheckSameSize(lhs, rhs);
+    Matrix result = lhs;
+    for (size_t i = 0; i < result.data_.size(); i++)
+      result.data_[i] -= rhs.data_[i];
+    return result;
+  }
+
+  /**
+   * Throws an std::invalid_argument if lhs.columns() != rhs.rows().
+   */
+  friend Matrix operator*(const Matrix& lhs, const Matrix& rhs) {
+    if (lhs.columns_ != rhs.rows_)
+      throw std::invalid_argument("Matrix - incompatible sizes for multiplication");
+    return Multiply(lhs, rhs, detail::is_modular_field<T>());
+  }
+
+  /**
+   * Returns matrix times column vector.
+   */
+  friend std::vector<T> operator*(const Matrix& lhs, const std::vector<T>& rhs) {
+    if (lhs.columns_ != rhs.size())
+      throw std::invalid_argument("Matrix - incompatible sizes for multiplication");
+    std::vector<T> result(lhs.rows_);
+    for (size_t i = 0; i < lhs.rows_; i++)
+      for (size_t k = 0; k < lhs.columns_; k++)
+        result[i] += lhs(i, k) * rhs[k];
+    return result;
+  }
+
+  void operator+=(const Matrix& rhs) {
+    *this = *this + rhs;
+  }
+
+  void operator-=(const Matrix& rhs) {
+    *this = *this - rhs;
+  }
+
+  void operator*=(const Matrix& rhs) {
+    *this = *this * rhs;
+  }
+
+  friend bool operator==(const Matrix& lhs, const Matrix& rhs) {
+    return lhs.rows_ == rhs.rows_ && lhs.columns_ == rhs.columns_ && lhs.data_ == rhs.data_;
+  }
+
+  friend bool operator!=(const Matrix& lhs, const Matrix& rhs) {
+    return !(lhs == rhs);
+  }
+
+private:
+  static void CheckSameSize(const Matrix& lhs, const Matrix& rhs) {
+    if (lhs.rows_ != rhs.rows_ || lhs.columns_ != rhs.columns_)
+      throw std::invalid_argument("Matrix - matrices of different sizes");
+  }
+
+  /**
+   * Generic tiled multiplication.
+   */
+  static Matrix Multiply(const Matrix& lhs, const Matrix& rhs, std::false_type) {
+    const Matrix rhs_transposed = rhs.transposed();
+    const size_t depth = lhs.columns_;
+    Matrix result(lhs.rows_, rhs.columns_);
+    ForEachTile(result, [&](size_t i, size_t j) {
+      const T* row = &lhs.data_[i * depth];
+      const T* column = &rhs_transposed.data_[j * depth];
+      T sum = T();
+      for (size_t k = 0; k < depth; k++)
+        sum += row[k] * column[k];
+      result(i, j) = sum;
+    });
+    return result;
+  }
+
+  /**
+   * Tiled multiplication with delayed reduction.
+   *
+   * Reduction is not done once per tile: a uint64 sum holds only
+   * max / (modulo - 1)^2 products (18 for primes near 10^9), so every
+   * chunk of that many terms is reduced separately to avoid overflow.
+   */
+  static Matrix Multiply(const Matrix& lhs, const Matrix& rhs, std::true_type) {
+    const uint64 modulo = detail::FieldModulo<T>();
+    const uint64 max_product = (modulo - 1) * (modulo - 1);
+    const size_t depth = lhs.columns_;
+    const size_t chunk = (max_product == 0)?
+        std::max<size_t>(depth, 1) : size_t(std::max<uint64>(1, std::numeric_limits<uint64>::max() / max_product));
+
+    std::vector<uint32> row_values(lhs.data_.size());
+    for (size_t i = 0; i < lhs.data_.size(); i++)
+      row_values[i] = lhs.data_[i].value();
+    std::vector<uint32> column_values(rhs.data_.size());
+    for (size_t k = 0; k < rhs.rows_; k++)
+      for (size_t j = 0; j < rhs.columns_; j++)
+        column_values[j * depth + k] = rhs(k, j).value();
+
+    Matrix result(lhs.rows_, rhs.columns_);
+    ForEachTile(result, [&](size_t i, size_t j) {
+      const uint32* row = &row_values[i * depth];
+      const uint32* column = &column_values[j * depth];
+      uint64 sum = 0;
+      for (size_t begin = 0; begin < depth; begin += chunk) {
+        const size_t end = std::min(depth, begin + chunk);
+        uint64 part = 0;
+        for (size_t k = begin; k < end; k++)
+          part += uint64(row[k]) * uint64(column[k]);
+        sum += part % modulo;
+      }
+      result(i, j) = sum;
+    });
+    return result;
+  }
+
+  /**
+   * Calls function(i, j) for every cell of result, tile by tile,
+   * so rows of both operands used by a tile stay in cache.
+   */
+  template <typename Function>
+  static void ForEachTile(const Matrix& result, Function function) {
+    const size_t block = detail::kMatrixBlockSize;
+    for (size_t row_block = 0; row_block < result.rows_; row_block += block)
+      for (size_t column_block = 0; column_block < result.columns_; column_block += block)
+        for (size_t i = row_block; i < std::min(result.rows_, row_block + block); i++)
+          for (size_t j = column_block; j < std::min(result.columns_, column_block + block); j++)
+            function(i, j);
+  }
+
+  size_t rows_;
+  size_t columns_;
+  std::vector<T> data_;
+};
+
+/**
+ * Returns a^n, a must be square.
+ */
+template <typename T>
+Matrix<T> power(const Matrix<T>& a, uint64 n) {
+  if (a.rows() != a.columns())
+    throw std::invalid_argument("Matrix - power of non square matrix");
+  return lib::power(a, n, Matrix<T>::Identity(a.rows()));
+}
+
+/**
+ * Returns the shortest linear recurrence generating sequence.
+ *
+ * Result c_1, c_2, ..., c_k satisfies s_n = c_1 s_{n-1} + ... + c_k s_{n-k}
+ * for every n >= k. Uses Berlekamp-Massey algorithm, which is O(n^2).
+ * For recurrence of order k, 2k terms of sequence are enough.
+ * T must be a field (ie prime_field).
+ *
+ * Example:
+ * <pre>
+ * BerlekampMassey<field>({0, 1, 1, 2, 3, 5, 8}); // {1, 1}
+ * </pre>
+ */
+template <typename T>
+std::vector<T> BerlekampMassey(const std::vector<T>& sequence) {
+  std::vector<T> current, previous;
+  T previous_discrepancy = 1;
+  size_t shift = 0; // number of steps since last length change
+  for (size_t n = 0; n < sequence.size(); n++) {
+    shift++;
+    T discrepancy = sequence[n];
+    for (size_t i = 0; i < current.size(); i++)
+      discrepancy -= current[i] * sequence[n - 1 - i];
+    if (discrepancy == 0)
+      continue;
+
+    const T factor = discrepancy / previous_discrepancy;
+    std::vector<T> next = current;
+    if (next.size() < previous.size() + shift)
+      next.resize(previous.size() + shift);
+    next[shift - 1] += factor;
+    for (size_t i = 0; i < previous.size(); i++)
+      next[shift + i] -= factor * previous[i];
+
+    if (2 * current.size() <= n) {
+      previous = current;
+      previous_discrepancy = discrepancy;
+      shift = 0;
+    }
+    current = std::move(next);
+  }
+  return current;
+}
+
+namespace detail {
+
+/**
+ * Returns lhs * rhs modulo x^k - c_1 x^{k-1} - ... - c_k, where
+ * k = coefficients.size() and lhs, rhs have degree smaller than k.
+ */
+template <typename T>
+std::vector<T> MultiplyModuloRecurrence(const std::vector<T>& lhs, const std::vector<T>& rhs,
+                                        const std::vector<T>& coefficients) {
+  const size_t k = coefficients.size();
+  std::vector<T> product(2 * k - 1);
+  for (size_t i = 0; i < k; i++) {
+    if (lhs[i] == 0)
+      continue;
+    for (size_t j = 0; j < k; j++)
+      product[i + j] += lhs[i] * rhs[j];
+  }
+  for (size_t i = 2 * k - 1; i-- > k;) {
+    if (product[i] == 0)
+      continue;
+    for (size_t j = 0; j < k; j++)
+      product[i - 1 - j] += product[i] * coefficients[j];
+  }
+  product.resize(k);
+  return product;
+}
+
+} // namespace detail
+
+/**
+ * Returns n-th term (counting from 0) of linear recurrence
+ * s_n = c_1 s_{n-1} + ... + c_k s_{n-k}, where coefficients = {c_1, ..., c_k}
+ * and initial = {s_0, ..., s_{k-1}}.
+ *
+ * Uses Kitamasa method, ie computes x^n modulo characteristic polynomial,
+ * computational complexity is O(k^2 log n) instead of O(k^3 log n)
+ * of matrix power.
+ *
+ * Example:
+ * <pre>
+ * LinearRecurrenceTerm<field>({1, 1}, {0, 1}, 10); // 55
+ * </pre>
+ */
+template <typename T>
+T LinearRecurrenceTerm(const std::vector<T>& coefficients, const std::vector<T>& initial, uint64 n) {
+  const size_t k = coefficients.size();
+  if (initial.size() < k)
+    throw std::invalid_argument("LinearRecurrenceTerm - not enough initial terms");
+  if (n < initial.size())
+    return initial[n];
+  if (k == 0)
+    return 0;
+
+  std::vector<T> result(k), base(k);
+  result[0] = 1; // x^0
+  if (k == 1)
+    base[0] = coefficients[0]; // x = c_1 modulo x - c_1
+  else
+    base[1] = 1; // x
+  while (n > 0) {
+    if (n % 2 != 0)
+      result = detail::MultiplyModuloRecurrence(result, base, coefficients);
+    n /= 2;
+    if (n > 0)
+      base = detail::MultiplyModuloRecurrence(base, base, coefficients);
+  }
+
+  T term = 0;
+  for (size_t i = 0; i < k; i++)
+    term += result[i] * initial[i];
+  return term;
+}
+
+} // namespace numeric
+} // namespace lib
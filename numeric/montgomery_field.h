@@ -0,0 +1,220 @@
+#pragma once
+// Jakub Staroń, 2016
+
+#include "headers.h"
+#include "numeric/prime_field.h"
+
+namespace lib {
+namespace numeric {
+
+// Predeclarations
+
+template <uint32 prime>
+class montgomery_field;
+
+/**
+ * Returns a^n in Z_prime.
+ */
+template<uint32 prime>
+montgomery_field<prime> power(montgomery_field<prime> a, uint64 n);
+
+/**
+ * Returns 1/lhs in Z_prime.
+ *
+ * Throws an std::runtime_error if lhs is not inversible (ie is 0).
+ */
+template<uint32 prime>
+montgomery_field<prime> inverse(const montgomery_field<prime>& lhs);
+
+template<uint32 prime>
+std::ostream& operator<<(std::ostream& stream, const montgomery_field<prime>& lhs);
+
+template<uint32 prime>
+std::istream& operator>>(std::istream& stream, montgomery_field<prime>& lhs);
+
+// Predeclarations End
+
+namespace detail {
+
+constexpr uint32 montgomery_inverse_step(uint32 prime, uint32 x, uint32 steps) {
+  return (steps == 0)? x : montgomery_inverse_step(prime, x * (2u - prime * x), steps - 1);
+}
+
+/**
+ * Returns x such that prime * x = 1 (mod 2^32).
+ *
+ * Uses Newton iteration, every step doubles number of correct bits.
+ * prime * prime = 1 (mod 8) gives first three bits.
+ */
+constexpr uint32 montgomery_inverse(uint32 prime) {
+  return montgomery_inverse_step(prime, prime, 4);
+}
+
+/**
+ * Returns (high - subtrahend) (mod prime) without branching.
+ */
+constexpr uint32 montgomery_subtract(uint32 high, uint32 subtrahend, uint32 prime) {
+  return high - subtrahend + (prime & (0u - uint32(high < subtrahend)));
+}
+
+/**
+ * Returns value / 2^32 (mod prime).
+ *
+ * value must be smaller than prime * 2^32, inverse is
+ * montgomery_inverse(prime).
+ */
+constexpr uint32 montgomery_reduce(uint64 value, uint32 prime, uint32 inverse) {
+  return montgomery_subtract(
+      uint32(value >> 32),
+      uint32((uint64(uint32(value) * inverse) * prime) >> 32),
+      prime);
+}
+
+} // namespace detail
+
+/**
+ * Integers modulo compiled-time odd prime kept in Montgomery form.
+ *
+ * Has the same interface as prime_field, but multiplication
+ * doesn't use division. Addition, subtraction and multiplication
+ * are branch free, so loops over vectors of montgomery_field
+ * can be vectorized by compiler.
+ */
+template <uint32 prime>
+class montgomery_field {
+  static_assert(prime % 2 == 1, "montgomery_field - prime must be odd");
+
+  static constexpr uint32 kInverse = detail::montgomery_inverse(prime);
+  static constexpr uint32 kR2 = (uint64(0) - uint64(prime)) % uint64(prime); // 2^64 (mod prime)
+
+  struct raw_tag { };
+
+  constexpr montgomery_field(uint32 raw, raw_tag):
+      value_(raw) { }
+
+  static constexpr uint32 reduce(uint64 value) {
+    return detail::montgomery_reduce(value, prime, kInverse);
+  }
+
+public:
+  constexpr montgomery_field():
+      value_(0) { }
+
+  template <typename Integral, typename = typename std::enable_if<std::is_integral<Integral>::value>::type>
+  constexpr montgomery_field(Integral value):
+      value_(reduce(uint64(detail::modulo(value, prime)) * kR2)) { }
+
+  friend constexpr montgomery_field operator+(const montgomery_field& lhs, const montgomery_field& rhs) {
+    return montgomery_field(detail::montgomery_subtract(lhs.value_, prime - rhs.value_, prime), raw_tag());
+  }
+
+  friend constexpr montgomery_field operator-(const montgomery_field& lhs, const montgomery_field& rhs) {
+    return montgomery_field(detail::montgomery_subtract(lhs.value_, rhs.value_, prime), raw_tag());
+  }
+
+  friend constexpr montgomery_field operator*(const montgomery_field& lhs, const montgomery_field& rhs) {
+    return montgomery_field(reduce(uint64(lhs.value_) * uint64(rhs.value_)), raw_tag());
+  }
+
+  friend montgomery_field power <>(montgomery_field a, uint64 n);
+  friend montgomery_field inverse <>(const montgomery_field& lhs);
+
+  /**
+   * Returns lhs/rhs in Z_prime.
+   */
+  friend montgomery_field operator/(const montgomery_field& lhs, const montgomery_field& rhs) {
+    return lhs * inverse(rhs);
+  }
+
+  void operator+=(const montgomery_field& rhs);
+  void operator-=(const montgomery_field& rhs);
+  void operator*=(const montgomery_field& rhs);
+  void operator/=(const montgomery_field& rhs);
+
+  friend constexpr bool operator==(const montgomery_field& lhs, const montgomery_field& rhs) {
+    return lhs.value_ == rhs.value_;
+  }
+
+  friend constexpr bool operator!=(const montgomery_field& lhs, const montgomery_field& rhs) {
+    return !(lhs == rhs);
+  }
+
+  /**
+   * Returns conversion of value to uint32.
+   */
+  constexpr uint32 value() const {
+    return reduce(value_);
+  }
+
+  friend std::ostream& operator<< <>(std::ostream& stream, const montgomery_field& lhs);
+  friend std::istream& operator>> <>(std::istream& stream, montgomery_field& lhs);
+
+private:
+  uint32 value_;
+};
+
+template <uint32 prime>
+constexpr uint32 montgomery_field<prime>::kInverse;
+
+template <uint32 prime>
+constexpr uint32 montgomery_field<prime>::kR2;
+
+template<uint32 prime>
+montgomery_field<prime> power(montgomery_field<prime> a, uint64 n) {
+  if (n == 0)
+    return 1;
+  else if (a == 0)
+    return 0;
+  n %= (prime - 1); // Fermat little theorem
+  montgomery_field<prime> result = 1;
+  while (n > 0) {
+    if (n % 2 == 1)
+      result *= a;
+    a *= a;
+    n /= 2;
+  }
+  return result;
+}
+
+template<uint32 prime>
+montgomery_field<prime> inverse(const montgomery_field<prime>& lhs) {
+  if (lhs == 0)
+    throw std::runtime_error("montgomery_field - inverse of zero");
+  return power(lhs, prime - 2);
+}
+
+template<uint32 prime>
+void montgomery_field<prime>::operator+=(const montgomery_field<prime>& rhs) {
+  *this = *this + rhs;
+}
+
+template<uint32 prime>
+void montgomery_field<prime>::operator-=(const montgomery_field<prime>& rhs) {
+  *this = *this - rhs;
+}
+
+template<uint32 prime>
+void montgomery_field<prime>::operator*=(const montgomery_field<prime>& rhs) {
+  *this = *this * rhs;
+}
+
+template<uint32 prime>
+void montgomery_field<prime>::operator/=(const montgomery_field<prime>& rhs) {
+  *this = *this / rhs;
+}
+
+template<uint32 prime>
+std::ostream& operator<<(std::ostream& stream, const montgomery_field<prime>& lhs) {
+  return stream << lhs.value();
+}
+
+template<uint32 prime>
+std::istream& operator>>(std::istream& stream, montgomery_field<prime>& lhs) {
+  int64 value;
+  stream >> value;
+  lhs = montgomery_field<prime>(value);
+  return stream;
+}
+
+} // namespace numeric
+} // namespace lib
@@ -3,6 +3,7 @@
 
 #include "headers.h"
 #include "numeric.h"
+#include "data_structures/flat_hash_map.h"
 
 namespace lib {
 namespace numeric {
@@ -177,14 +178,26 @@ uint64 Subtract64(uint64 a, uint64 b, uint64 modulo) {
 /**
  * Returns (a * b) (mod modulo)
  *
- * Note that 2 * modulo should be smaller than 2^64.
+ * For modulo smaller than 2^62 quotient is estimated using long double,
+ * so no loop nor uint128 is needed. Otherwise uses double-and-add loop.
  */
 uint64 Multiply64(uint64 a, uint64 b, uint64 modulo) {
+  a %= modulo;
+  b %= modulo;
+  if (std::numeric_limits<long double>::digits >= 64 && modulo < (1uLL << 62)) {
+    const uint64 quotient = uint64(static_cast<long double>(a) * b / modulo);
+    const int64 result = int64(a * b - quotient * modulo); // quotient is off by at most one
+    if (result < 0)
+      return uint64(result) + modulo;
+    return (uint64(result) >= modulo)? uint64(result) - modulo : uint64(result);
+  }
+
+  auto add = [modulo](uint64 x, uint64 y) { return (x >= modulo - y)? x - (modulo - y) : x + y; };
   uint64 result = 0;
   while (b > 0) {
     if(b % 2 == 1)
-      result = Add64(result, a, modulo);
-    a = Add64(a, a, modulo);
+      result = add(result, a);
+    a = add(a, a);
     b /= 2;
   }
   return result;
@@ -192,12 +205,120 @@ uint64 Multiply64(uint64 a, uint64 b, uint64 modulo) {
 
 #endif
 
+/**
+ * Returns floor(a * b / 2^64).
+ */
+inline uint64 MultiplyHigh64(uint64 a, uint64 b) {
+#ifdef USE_INT128_TYPES
+  return uint64((uint128(a) * uint128(b)) >> 64);
+#else
+  const uint64 a_low = uint32(a), a_high = a >> 32;
+  const uint64 b_low = uint32(b), b_high = b >> 32;
+  const uint64 low_high = a_low * b_high;
+  const uint64 high_low = a_high * b_low;
+  const uint64 middle = ((a_low * b_low) >> 32) + uint32(high_low) + low_high; // can't overflow
+  return a_high * b_high + (high_low >> 32) + (middle >> 32);
+#endif
+}
+
+/**
+ * Arithmetic modulo odd 64 bits modulo in Montgomery form.
+ *
+ * Values passed to and returned by add, subtract, multiply and power
+ * are in Montgomery form, ie x is represented as x * 2^64 (mod modulo).
+ * Use toMontgomery and fromMontgomery for conversions.
+ * Multiplication needs no division and no uint128.
+ *
+ * Example:
+ * <pre>
+ * Montgomery64 montgomery(modulo);
+ * uint64 x = montgomery.toMontgomery(a);
+ * uint64 result = montgomery.fromMontgomery(montgomery.multiply(x, x)); // a * a (mod modulo)
+ * </pre>
+ */
+class Montgomery64 {
+public:
+  explicit Montgomery64(uint64 modulo):
+      modulo_(modulo),
+      inverse_(modulo) {
+    assert(modulo % 2 == 1);
+    for (int i = 0; i < 5; ++i) // Newton iteration, every step doubles number of correct bits
+      inverse_ *= 2 - modulo * inverse_;
+    one_ = (0 - modulo) % modulo;
+    r2_ = one_;
+    for (int i = 0; i < 64; ++i)
+      r2_ = add(r2_, r2_);
+  }
+
+  uint64 modulo() const {
+    return modulo_;
+  }
+
+  /**
+   * Returns 1 in Montgomery form.
+   */
+  uint64 one() const {
+    return one_;
+  }
+
+  uint64 toMontgomery(uint64 value) const {
+    return multiply(value % modulo_, r2_);
+  }
+
+  uint64 fromMontgomery(uint64 value) const {
+    return reduce(value, 0);
+  }
+
+  uint64 add(uint64 a, uint64 b) const {
+    return (a >= modulo_ - b)? a - (modulo_ - b) : a + b;
+  }
+
+  uint64 subtract(uint64 a, uint64 b) const {
+    return (a >= b)? a - b : a - b + modulo_;
+  }
+
+  uint64 multiply(uint64 a, uint64 b) const {
+    return reduce(a * b, MultiplyHigh64(a, b));
+  }
+
+  uint64 power(uint64 a, uint64 n) const {
+    uint64 result = one_;
+    while (n > 0) {
+      if (n % 2 != 0)
+        result = multiply(result, a);
+      n /= 2;
+      a = multiply(a, a);
+    }
+    return result;
+  }
+
+private:
+  /**
+   * Returns (high * 2^64 + low) / 2^64 (mod modulo).
+   */
+  uint64 reduce(uint64 low, uint64 high) const {
+    const uint64 subtrahend = MultiplyHigh64(low * inverse_, modulo_);
+    return (high >= subtrahend)? high - subtrahend : high - subtrahend + modulo_;
+  }
+
+  uint64 modulo_;
+  uint64 inverse_;
+  uint64 one_;
+  uint64 r2_;
+};
+
 /**
  * Returns a^n (mod modulo)
  *
- * Note that this version uses uint128, which can be slow.
+ * For odd modulo uses Montgomery64, so it is fast
+ * with and without uint128.
  */
 uint64 PowerModulo64(uint64 a, uint64 n, uint64 modulo) {
+  if (modulo % 2 == 1 && modulo > 1) {
+    const Montgomery64 montgomery(modulo);
+    return montgomery.fromMontgomery(montgomery.power(montgomery.toMontgomery(a), n));
+  }
+
   uint64 result = 1;
   while (n > 0) {
     if (n % 2 != 0)
@@ -208,12 +329,178 @@ uint64 PowerModulo64(uint64 a, uint64 n, uint64 modulo) {
   return result;
 }
 
+/**
+ * Linear sieve of smallest prime factors of numbers smaller than n.
+ *
+ * Every composite number is crossed off exactly once, by its
+ * smallest prime factor. Table takes 4n bytes. Factorization
+ * and divisors of numbers smaller than n are found by table walk.
+ *
+ * Example:
+ * <pre>
+ * LinearSieve sieve(Million);
+ * sieve.factorize(360); // returns {2, 2, 2, 3, 3, 5}
+ * auto phi = sieve.totients(); // phi[k] is Euler's totient of k
+ * </pre>
+ */
+class LinearSieve {
+public:
+  explicit LinearSieve(uint32 n):
+      smallest_factor_(n, 0) {
+    for (uint32 i = 2; i < n; ++i) {
+      if (smallest_factor_[i] == 0) {
+        smallest_factor_[i] = i;
+        primes_.push_back(i);
+      }
+      const uint32 limit = std::min(smallest_factor_[i], (n - 1) / i);
+      for (const uint32 p: primes_) {
+        if (p > limit)
+          break;
+        smallest_factor_[i * p] = p;
+      }
+    }
+  }
+
+  /**
+   * Returns bound of sieve, ie n.
+   */
+  uint32 size() const {
+    return uint32(smallest_factor_.size());
+  }
+
+  /**
+   * Returns primes smaller than n in increasing order.
+   */
+  const std::vector<uint32>& primes() const {
+    return primes_;
+  }
+
+  /**
+   * Returns smallest prime factor of k. k must be in [2, n).
+   */
+  uint32 smallestPrimeFactor(uint32 k) const {
+    return smallest_factor_[k];
+  }
+
+  bool isPrime(uint32 k) const {
+    return k >= 2 && smallest_factor_[k] == k;
+  }
+
+  /**
+   * Returns factorization of k < n in increasing order.
+   *
+   * Computational complexity is O(log k).
+   */
+  std::vector<uint32> factorize(uint32 k) const {
+    std::vector<uint32> result;
+    while (k > 1) {
+      result.push_back(smallest_factor_[k]);
+      k /= smallest_factor_[k];
+    }
+    return result;
+  }
+
+  /**
+   * Returns divisors of k < n in increasing order.
+   *
+   * Computational complexity is O(d(k) log d(k)).
+   */
+  std::vector<uint32> divisors(uint32 k) const {
+    if (k == 0)
+      return {};
+    std::vector<uint32> result = {1};
+    while (k > 1) {
+      const uint32 p = smallest_factor_[k];
+      const size_t size = result.size();
+      for (uint32 power = p; k % p == 0; k /= p, power *= p)
+        for (auto i: range<size_t>(0, size))
+          result.push_back(result[i] * power);
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+  }
+
+  /**
+   * Returns values of multiplicative function f for 0, 1, ..., n - 1.
+   *
+   * f is defined by prime_power(p, e, p^e), which returns f(p^e).
+   * f(1) is 1 and f(0) is T(). Computational complexity is O(n).
+   *
+   * Example:
+   * <pre>
+   * // number of divisors
+   * auto d = sieve.multiplicative<uint32>([](uint32 p, uint32 e, uint32 pe) { return e + 1; });
+   * </pre>
+   */
+  template <typename T, typename PrimePower>
+  std::vector<T> multiplicative(PrimePower prime_power) const {
+    std::vector<T> values(size());
+    if (size() > 1)
+      values[1] = T(1);
+    for (uint32 i = 2; i < size(); ++i) {
+      const uint32 p = smallest_factor_[i];
+      uint32 rest = i / p, power = p, exponent = 1;
+      while (rest % p == 0) {
+        rest /= p;
+        power *= p;
+        exponent++;
+      }
+      values[i] = (rest == 1)? T(prime_power(p, exponent, power)) : T(values[rest] * values[power]);
+    }
+    return values;
+  }
+
+  /**
+   * Returns values of Euler's totient function for 0, 1, ..., n - 1.
+   */
+  std::vector<uint32> totients() const {
+    return multiplicative<uint32>([](uint32 p, uint32, uint32 power) { return power - power / p; });
+  }
+
+  /**
+   * Returns values of Mobius function for 0, 1, ..., n - 1.
+   */
+  std::vector<int8> mobius() const {
+    return multiplicative<int8>([](uint32, uint32 exponent, uint32) { return (exponent == 1)? -1 : 0; });
+  }
+
+  /**
+   * Returns numbers of divisors of 0, 1, ..., n - 1.
+   */
+  std::vector<uint32> divisorCounts() const {
+    return multiplicative<uint32>([](uint32, uint32 exponent, uint32) { return exponent + 1; });
+  }
+
+private:
+  std::vector<uint32> smallest_factor_;
+  std::vector<uint32> primes_;
+};
+
+constexpr uint64 kPrimesPreprocessedNumber = 1 * 1000 * 1000;
+constexpr uint64 kMaxFactorizableNumber = kPrimesPreprocessedNumber * kPrimesPreprocessedNumber;
+
+namespace detail {
+
+/**
+ * Returns LinearSieve over numbers smaller than kPrimesPreprocessedNumber.
+ */
+const LinearSieve& PreprocessedSieve() {
+  static const LinearSieve sieve(kPrimesPreprocessedNumber);
+  return sieve;
+}
+
+} // namespace detail
+
 /**
  * Returns vector of divisors of n in increasing order.
  *
- * Computational complexity is O(sqrt(n)).
+ * For n smaller than kPrimesPreprocessedNumber uses preprocessed
+ * LinearSieve, otherwise computational complexity is O(sqrt(n)).
  */
 std::vector<uint32> Divisors(uint32 n) {
+  if (n < kPrimesPreprocessedNumber)
+    return detail::PreprocessedSieve().divisors(n);
+
   std::vector<uint32> result;
   for (uint64 i = 1; i * i <= n; ++i) {
     if (divides<uint32>(i, n)) {
@@ -227,25 +514,352 @@ std::vector<uint32> Divisors(uint32 n) {
   return result;
 }
 
+namespace detail {
+
+constexpr uint64 kWheelWords = 3 * 5 * 7 * 11;
+
 /**
- * Returns bit_vector of size n.
+ * Returns wheel pattern for odd numbers.
  *
- * ith bit is on when and only when i is prime number.
+ * ith bit of pattern represents odd number 2i + 1 and is on when
+ * number is not divisible by 3, 5, 7 nor 11. Pattern consists
+ * of kWheelWords words, so it is periodic on word boundaries.
+ */
+const std::vector<uint64>& WheelPattern() {
+  static const std::vector<uint64> pattern = [] {
+    std::vector<uint64> result(kWheelWords, ~uint64(0));
+    for (uint64 p: {3, 5, 7, 11})
+      for (uint64 i = (p - 1) / 2; i < kWheelWords * 64; i += p)
+        result[i / 64] &= ~(uint64(1) << (i % 64));
+    return result;
+  }();
+  return pattern;
+}
+
+} // namespace detail
+
+/**
+ * Segmented sieve of Eratostenes over range [begin, end).
+ *
+ * Only odd numbers are stored, one bit per number. Segment
+ * of kSegmentWords words fits in L1 cache. Every segment starts
+ * as a copy of wheel pattern, so multiples of 3, 5, 7 and 11
+ * are never crossed off explicitly. Memory usage is
+ * O(sqrt(end) / log(end)) for sieving primes, full table is never held.
  *
- * Algorithm used is Eratostenes sieve. For comparison with other sieves
- * see benchmarks.
+ * Example:
+ * <pre>
+ * SegmentedSieve sieve(Billion, Billion + Million);
+ * sieve.forEachPrime([](uint64 p) { std::cout << p << std::endl; });
+ * </pre>
  */
-bit_vector Sieve(uint32 n) {
-  bit_vector V(n, true);
-  V[0] = V[1] = 0;
+class SegmentedSieve {
+public:
+  static constexpr uint64 kSegmentWords = 1 << 12; // 32 KiB
+  static constexpr uint64 kSegmentBits = kSegmentWords * 64;
+
+  SegmentedSieve(uint64 begin, uint64 end):
+      begin_(begin),
+      end_(std::max(begin, end)),
+      words_(kSegmentWords) {
+    const uint64 root = (end_ > 0)? SquareFloor(end_ - 1) : 0;
+    if (root >= 13)
+      SegmentedSieve(13, root + 1).forEachPrime([this](uint64 p) { primes_.push_back(uint32(p)); });
+    offsets_.resize(primes_.size());
+  }
+
+  /**
+   * Constructs sieve over [begin, end) reusing sieving primes of other.
+   *
+   * end must not be greater than end of other. Useful when many
+   * sieves over parts of bigger range are created.
+   */
+  SegmentedSieve(uint64 begin, uint64 end, const SegmentedSieve& other):
+      begin_(begin),
+      end_(std::max(begin, end)),
+      primes_(other.primes_),
+      offsets_(primes_.size()),
+      words_(kSegmentWords) {
+    assert(end_ <= other.end_);
+  }
 
+  uint64 begin() const {
+    return begin_;
+  }
 
-  for(uint32 x = 2; x * x < n ; ++x) {
-    if(V[x])
-      for(uint32 y = x * x ; y < n ; y += x)
-        V[y] = 0;
+  uint64 end() const {
+    return end_;
   }
 
+  /**
+   * Calls callback(p) for every prime p in [begin, end) in increasing order.
+   */
+  template <typename Callback>
+  void forEachPrime(Callback callback) {
+    for (uint64 p: {2, 3, 5, 7, 11})
+      if (begin_ <= p && p < end_)
+        callback(p);
+
+    for (uint64 base = reset(); 2 * base + 1 < end_; base += kSegmentBits) {
+      sieveSegment(base);
+      for (auto w: range<uint64>(0, kSegmentWords)) {
+        uint64 word = words_[w];
+        while (word != 0) {
+          const uint64 p = 2 * (base + 64 * w + least_significant_one(word)) + 1;
+          if (p >= end_)
+            return;
+          if (p >= begin_)
+            callback(p);
+          word &= word - 1;
+        }
+      }
+    }
+  }
+
+  /**
+   * Returns number of primes in [begin, end).
+   */
+  uint64 count() {
+    uint64 result = 0;
+    for (uint64 p: {2, 3, 5, 7, 11})
+      if (begin_ <= p && p < end_)
+        result++;
+
+    for (uint64 base = reset(); 2 * base + 1 < end_; base += kSegmentBits) {
+      sieveSegment(base);
+      for (auto w: range<uint64>(0, kSegmentWords)) {
+        const uint64 first = 2 * (base + 64 * w) + 1;
+        if (first >= end_)
+          break;
+        uint64 word = words_[w];
+        if (first < begin_ || first + 127 > end_) {
+          for (auto b: range<uint64>(0, 64)) {
+            const uint64 n = first + 2 * b;
+            if (n < begin_ || n >= end_)
+              word &= ~(uint64(1) << b);
+          }
+        }
+        result += pop_count(word);
+      }
+    }
+    return result;
+  }
+
+private:
+  /**
+   * Sets offsets of sieving primes to their first odd multiples
+   * in the sieved range and returns index of first segment.
+   */
+  uint64 reset() {
+    const uint64 base = (begin_ / 2) & ~uint64(63);
+    for (auto i: range<size_t>(0, primes_.size())) {
+      const uint64 p = primes_[i];
+      uint64 multiple = std::max(p * p, 2 * base + 1);
+      multiple = (multiple + p - 1) / p * p;
+      if (multiple % 2 == 0)
+        multiple += p;
+      offsets_[i] = multiple / 2;
+    }
+    return base;
+  }
+
+  /**
+   * Sieves odd numbers 2i + 1 for i in [base, base + kSegmentBits).
+   */
+  void sieveSegment(uint64 base) {
+    const auto& pattern = detail::WheelPattern();
+    uint64 offset = (base / 64) % detail::kWheelWords;
+    for (uint64 w = 0; w < kSegmentWords; ) {
+      const uint64 length = std::min(kSegmentWords - w, detail::kWheelWords - offset);
+      std::memcpy(&words_[w], &pattern[offset], length * sizeof(uint64));
+      w += length;
+      offset = 0;
+    }
+    if (base == 0)
+      words_[0] &= ~uint64(1); // 1 is not a prime
+
+    const uint64 limit = base + kSegmentBits;
+    for (auto i: range<size_t>(0, primes_.size())) {
+      const uint64 p = primes_[i];
+      uint64 j = offsets_[i];
+      for (; j < limit; j += p)
+        words_[(j - base) / 64] &= ~(uint64(1) << ((j - base) % 64));
+      offsets_[i] = j;
+    }
+  }
+
+  uint64 begin_;
+  uint64 end_;
+  std::vector<uint32> primes_;
+  std::vector<uint64> offsets_;
+  std::vector<uint64> words_;
+};
+
+constexpr uint64 SegmentedSieve::kSegmentWords;
+constexpr uint64 SegmentedSieve::kSegmentBits;
+
+/**
+ * Calls callback(p) for every prime p in [begin, end) in increasing order.
+ *
+ * Uses SegmentedSieve, so memory usage doesn't depend on end - begin.
+ */
+template <typename Callback>
+void ForEachPrime(uint64 begin, uint64 end, Callback callback) {
+  SegmentedSieve(begin, end).forEachPrime(callback);
+}
+
+/**
+ * Returns number of primes in [begin, end).
+ */
+uint64 CountPrimes(uint64 begin, uint64 end) {
+  return SegmentedSieve(begin, end).count();
+}
+
+namespace detail {
+
+/**
+ * Number of integers sieved by one task of parallel sieve, 2^22
+ * (8 segments of kSegmentBits odd numbers).
+ */
+constexpr uint64 kParallelSieveChunk = 8 * 2 * SegmentedSieve::kSegmentBits;
+
+} // namespace detail
+
+/**
+ * Splits [begin, end) into chunks and sieves them using threads workers.
+ *
+ * For every chunk calls callback(sieve), where sieve is SegmentedSieve&
+ * over that chunk, eg callback can call sieve.count() or sieve.forEachPrime().
+ * Callback is called concurrently from worker threads in no particular
+ * order, so it must be thread safe and must not throw.
+ */
+template <typename Callback>
+void ForEachSegmentParallel(uint64 begin, uint64 end, uint32 threads, Callback callback) {
+  end = std::max(begin, end);
+  const SegmentedSieve sieving(begin, end);
+  const uint64 chunks = ceiling_divide(end - begin, detail::kParallelSieveChunk);
+  std::atomic<uint64> next(0);
+
+  auto worker = [&]() {
+    for (uint64 i = next.fetch_add(1); i < chunks; i = next.fetch_add(1)) {
+      const uint64 chunk_begin = begin + i * detail::kParallelSieveChunk;
+      const uint64 chunk_end = std::min(end, chunk_begin + detail::kParallelSieveChunk);
+      SegmentedSieve sieve(chunk_begin, chunk_end, sieving);
+      callback(sieve);
+    }
+  };
+
+  std::vector<std::thread> workers;
+  for (uint32 i = 1; i < threads; ++i)
+    workers.emplace_back(worker);
+  worker();
+  for (auto& thread: workers)
+    thread.join();
+}
+
+/**
+ * Returns number of primes in [begin, end) using threads workers.
+ */
+uint64 CountPrimesParallel(uint64 begin, uint64 end, uint32 threads) {
+  std::atomic<uint64> result(0);
+  ForEachSegmentParallel(begin, end, threads, [&result](SegmentedSieve& sieve) {
+    result += sieve.count();
+  });
+  return result;
+}
+
+/**
+ * Calls callback(p) for every prime p in [begin, end) in increasing order.
+ *
+ * Chunks are sieved by threads workers, callback is called from
+ * calling thread. At most threads + 1 sieved chunks are kept in memory.
+ */
+template <typename Callback>
+void ForEachPrimeParallel(uint64 begin, uint64 end, uint32 threads, Callback callback) {
+  end = std::max(begin, end);
+  threads = std::max(threads, 1u);
+  const SegmentedSieve sieving(begin, end);
+  const uint64 chunks = ceiling_divide(end - begin, detail::kParallelSieveChunk);
+  const uint64 window = threads + 1;
+
+  std::mutex mutex;
+  std::condition_variable condition;
+  std::vector<std::vector<uint64>> results(chunks);
+  std::vector<bool> done(chunks, false);
+  uint64 scheduled = 0;
+  uint64 consumed = 0;
+  bool stopped = false;
+
+  auto worker = [&]() {
+    while (true) {
+      uint64 i;
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        condition.wait(lock, [&] { return stopped || scheduled == chunks || scheduled < consumed + window; });
+        if (stopped || scheduled == chunks)
+          return;
+        i = scheduled++;
+      }
+
+      const uint64 chunk_begin = begin + i * detail::kParallelSieveChunk;
+      const uint64 chunk_end = std::min(end, chunk_begin + detail::kParallelSieveChunk);
+      std::vector<uint64> primes;
+      SegmentedSieve(chunk_begin, chunk_end, sieving).forEachPrime([&primes](uint64 p) { primes.push_back(p); });
+
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        results[i] = std::move(primes);
+        done[i] = true;
+      }
+      condition.notify_all();
+    }
+  };
+
+  std::vector<std::thread> workers;
+  for (uint32 i = 0; i < threads; ++i)
+    workers.emplace_back(worker);
+
+  auto stop = [&]() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stopped = true;
+    }
+    condition.notify_all();
+    for (auto& thread: workers)
+      thread.join();
+  };
+
+  try {
+    for (uint64 i = 0; i < chunks; ++i) {
+      std::vector<uint64> primes;
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        condition.wait(lock, [&] { return bool(done[i]); });
+        primes = std::move(results[i]);
+        consumed = i + 1;
+      }
+      condition.notify_all();
+      for (auto p: primes)
+        callback(p);
+    }
+  } catch (...) {
+    stop();
+    throw;
+  }
+  stop();
+}
+
+/**
+ * Returns bit_vector of size n.
+ *
+ * ith bit is on when and only when i is prime number.
+ *
+ * Algorithm used is segmented Eratostenes sieve. For comparison
+ * with other sieves see benchmarks.
+ */
+bit_vector Sieve(uint32 n) {
+  bit_vector V(n, false);
+  ForEachPrime(0, n, [&V](uint64 p) { V[p] = true; });
   return V;
 }
 
@@ -253,29 +867,101 @@ bit_vector Sieve(uint32 n) {
  * Returns vector of primes less than n.
  */
 std::vector<uint32> PrimeNumbers(uint32 n) {
-  bit_vector primes = Sieve(n);
   std::vector<uint32> result;
-  uint32 count = 0;
-  for (uint32 i: range<uint32>(2, n))
-    if (primes[i]) count++;
-  result.reserve(count);
-  for (uint32 i: range<uint32>(2, n))
-    if (primes[i]) result.push_back(i);
+  if (n > 2)
+    result.reserve(size_t(1.26 * n / std::log(double(n))) + 1); // pi(n) < 1.26 n / ln n
+  ForEachPrime(0, n, [&result](uint64 p) { result.push_back(uint32(p)); });
   return result;
 }
 
-constexpr uint64 kPrimesPreprocessedNumber = 1 * 1000 * 1000;
-constexpr uint64 kMaxFactorizableNumber = kPrimesPreprocessedNumber * kPrimesPreprocessedNumber;
+/**
+ * Returns sum of f(p) over primes p not greater than n.
+ *
+ * f must be completely multiplicative, ie f(ab) = f(a)f(b) for all a, b.
+ * prefix(v) must return sum of f(k) for 2 <= k <= v.
+ * Uses Lucy's dynamic programming over values n / i, which needs
+ * O(sqrt(n)) memory and O(n^(3/4) / log n) time (not O(n^(2/3)), which
+ * would need sieving of small values with a Fenwick tree). Only ring
+ * operations are performed on T, so for unsigned T result is exact
+ * modulo 2^bits.
+ *
+ * Throws an std::invalid_argument if n >= (2^32 - 1)^2, as primes
+ * up to sqrt(n) are sieved as uint32.
+ *
+ * Example:
+ * <pre>
+ * // sum of squares of primes modulo 10^9 + 7
+ * using field = prime_field<1000 * 1000 * 1000 + 7>;
+ * SumOverPrimes<field>(n, [](uint64 p) { return field(p) * p; }, SumOfSquares);
+ * </pre>
+ */
+template <typename T, typename Function, typename PrefixSum>
+T SumOverPrimes(uint64 n, Function f, PrefixSum prefix) {
+  if (n < 2)
+    return T(0);
+
+  constexpr uint64 kMaxRoot = std::numeric_limits<uint32>::max();
+  if (n >= kMaxRoot * kMaxRoot)
+    throw std::invalid_argument("SumOverPrimes - n is too big");
+  const uint64 root = SquareFloor(n);
+  std::vector<T> small(root + 1); // small[v] = sum for values up to v
+  std::vector<T> large(root + 1); // large[i] = sum for values up to n / i
+  for (uint64 v = 1; v <= root; ++v) {
+    small[v] = prefix(v);
+    large[v] = prefix(n / v);
+  }
+
+  for (const uint64 p: PrimeNumbers(uint32(root + 1))) {
+    const uint64 square = p * p;
+    const T value = f(p);
+    const T previous = small[p - 1]; // sum over primes smaller than p
+
+    const uint64 limit = std::min(root, n / square);
+    for (uint64 i = 1; i <= limit; ++i) {
+      const uint64 d = i * p;
+      const T quotient = (d <= root)? large[d] : small[n / d];
+      large[i] = large[i] - value * (quotient - previous);
+    }
+    for (uint64 v = root; v >= square; --v)
+      small[v] = small[v] - value * (small[v / p] - previous);
+  }
+  return large[1];
+}
+
+/**
+ * Returns number of primes not greater than n.
+ *
+ * Computational complexity is O(n^(3/4) / log n), memory usage is O(sqrt(n)).
+ */
+uint64 PrimePi(uint64 n) {
+  return SumOverPrimes<uint64>(n, [](uint64) { return uint64(1); }, [](uint64 v) { return v - 1; });
+}
+
+/**
+ * Returns sum of primes not greater than n modulo 2^64.
+ *
+ * Result is exact for n up to about 2.9 * 10^10.
+ */
+uint64 PrimeSum(uint64 n) {
+  return SumOverPrimes<uint64>(n, [](uint64 p) { return p; }, [](uint64 v) {
+    return ((v % 2 == 0)? (v / 2) * (v + 1) : v * ((v + 1) / 2)) - 1;
+  });
+}
 
 /**
  * Returns factorization of n. Uses preprocessed primes to speed up factorization.
  *
- * Computational complexity is O(sqrt(n) / log n).
+ * For n smaller than kPrimesPreprocessedNumber walks preprocessed
+ * LinearSieve in O(log n), otherwise computational complexity
+ * is O(sqrt(n) / log n).
  */
 std::vector<uint32> Factorize(uint32 n) {
-  static std::vector<uint32> primes = PrimeNumbers(kPrimesPreprocessedNumber);
+  const LinearSieve& sieve = detail::PreprocessedSieve();
+  if (n < sieve.size())
+    return sieve.factorize(n);
+
   std::vector<uint32> result;
-  for (const uint64 p: primes) {
+  for (const uint64 p: sieve.primes()) {
     if (n == 1 || p * p > n)
       break;
 
@@ -312,27 +998,33 @@ struct MillerRabinPrimeTest {
       if (p == witness)
         return true;
 
+    if (p % 2 == 0)
+      return false;
+
     const uint64 odd_factor = (p - 1uLL) / (1uLL << least_significant_one(p - 1));
+    const Montgomery64 montgomery(p);
+    const uint64 one = montgomery.one();
+    const uint64 minus_one = p - one;
 
     for (const auto witness: witnesses) {
       uint64 k = odd_factor;
-      uint64 x = PowerModulo64(witness, k, p);
+      uint64 x = montgomery.power(montgomery.toMontgomery(witness), k);
 
-      if (x == 1 || x == (p - 1))
+      if (x == one || x == minus_one)
         continue;
 
       while (k < p - 1) {
-        x = Multiply64(x, x, p);
+        x = montgomery.multiply(x, x);
 
-        if (x == (p - 1))
+        if (x == minus_one)
           break;
-        else if (x == 1)
+        else if (x == one)
           return false;
 
         k *= 2;
       }
 
-      if (x != p - 1)
+      if (x != minus_one)
         return false;
     }
     return true;
@@ -365,6 +1057,98 @@ bool IsPrime(uint64 p)
     return big.test(p);
 }
 
+namespace detail {
+
+constexpr uint64 kTrialDivisionBound = 1 << 10;
+
+/**
+ * Returns nontrivial divisor of odd composite n.
+ *
+ * Uses Brent's variant of Pollard's rho algorithm. Products of
+ * differences are accumulated in batches, so GCD is computed rarely.
+ * Expected computational complexity is O(n^(1/4)) multiplications.
+ */
+uint64 PollardRho(uint64 n) {
+  constexpr uint64 kBatchSize = 128;
+  const Montgomery64 montgomery(n);
+
+  for (uint64 c = 1; ; ++c) {
+    const uint64 increment = montgomery.toMontgomery(c);
+    auto next = [&montgomery, increment](uint64 x) {
+      return montgomery.add(montgomery.multiply(x, x), increment);
+    };
+    auto difference = [](uint64 x, uint64 y) {
+      return (x > y)? x - y : y - x;
+    };
+
+    uint64 x = 0, y = montgomery.toMontgomery(2), saved = y;
+    uint64 product = montgomery.one();
+    uint64 divisor = 1;
+    for (uint64 length = 1; divisor == 1; length *= 2) {
+      x = y;
+      for (uint64 i = 0; i < length; ++i)
+        y = next(y);
+      for (uint64 k = 0; k < length && divisor == 1; k += kBatchSize) {
+        saved = y;
+        for (uint64 i = 0; i < std::min(kBatchSize, length - k); ++i) {
+          y = next(y);
+          product = montgomery.multiply(product, difference(x, y));
+        }
+        divisor = GCD(product, n);
+      }
+    }
+
+    if (divisor == n) { // batch overshot, repeat it step by step
+      do {
+        saved = next(saved);
+        divisor = GCD(difference(x, saved), n);
+      } while (divisor == 1);
+    }
+
+    if (divisor != n)
+      return divisor;
+  }
+}
+
+void Factorize64(uint64 n, std::vector<uint64>& result) {
+  if (n <= 1)
+    return;
+  if (n < kTrialDivisionBound * kTrialDivisionBound || IsPrime(n)) {
+    result.push_back(n);
+    return;
+  }
+  const uint64 divisor = PollardRho(n);
+  Factorize64(divisor, result);
+  Factorize64(n / divisor, result);
+}
+
+} // namespace detail
+
+/**
+ * Returns factorization of n in increasing order.
+ *
+ * Divides n by primes smaller than 2^10, remaining part is
+ * factorized by Pollard's rho algorithm and Miller-Rabin test.
+ * For n equal to 0 or 1 returns empty vector.
+ * Expected computational complexity is O(n^(1/4)).
+ */
+std::vector<uint64> Factorize64(uint64 n) {
+  static const std::vector<uint32> primes = PrimeNumbers(detail::kTrialDivisionBound);
+  std::vector<uint64> result;
+  for (const uint64 p: primes) {
+    if (p * p > n)
+      break;
+
+    while (n % p == 0) {
+      result.push_back(p);
+      n /= p;
+    }
+  }
+  detail::Factorize64(n, result);
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
 /**
  * Returns true if g is primitive root modulo p.
  * Note that p must be prime.
@@ -411,6 +1195,78 @@ uint32 MultiplicativeOrder(uint32 a, uint32 p) {
   assert(0 && "Impossible to reach.");
 }
 
+namespace detail {
+constexpr uint64 kDiscreteLogarithmMaxBabySteps = 1uLL << 22;
+} // namespace detail
+
+/**
+ * Baby-step giant-step solver for discrete logarithms in the base of a modulo p.
+ *
+ * Baby steps are computed once and kept in FlatHashMap, so answering
+ * many queries with the same base and modulo shares the table.
+ * Number of baby steps is chosen to balance table construction
+ * with expected number of queries, each query costs O(order / steps).
+ *
+ * Note that p must be a prime number.
+ * Also note that a, x, and p are 32 bits unsigned integers.
+ *
+ * Example:
+ * <pre>
+ * DiscreteLogarithmSolver solver(3, 7);
+ * solver.logarithm(5); // 5
+ * solver.logarithm(1); // 0
+ * </pre>
+ */
+class DiscreteLogarithmSolver {
+public:
+  DiscreteLogarithmSolver(uint32 a, uint32 p, uint32 queries = 1):
+      p_(p),
+      order_(MultiplicativeOrder(a, p)),
+      steps_(StepsFor(order_, queries)),
+      baby_steps_(steps_) {
+    uint32 power = 1;
+    for (uint32 j = 0; j < steps_; j++) {
+      baby_steps_.insert(power, j);
+      power = Multiply32(power, a % p, p);
+    }
+    giant_step_ = Inverse(PowerModulo32(a, steps_, p), p);
+  }
+
+  /**
+   * Returns the smallest k such that a^k = x (mod p).
+   *
+   * If x is not in orbit of a throws an exception of type std::runtime_error.
+   */
+  uint32 logarithm(uint32 x) const {
+    x %= p_;
+    const uint32 giant_steps = (order_ - 1) / steps_;
+    for (uint32 i = 0; i <= giant_steps; i++) {
+      if (const uint32* j = baby_steps_.find(x))
+        return uint32((uint64(i) * steps_ + *j) % order_);
+      x = Multiply32(x, giant_step_, p_);
+    }
+    throw std::runtime_error("DiscreteLogarithm - no logarithm found");
+  }
+
+  uint32 order() const {
+    return order_;
+  }
+
+private:
+  static uint32 StepsFor(uint32 order, uint32 queries) {
+    const uint64 balanced = std::min<uint64>(
+        SquareCeiling(uint64(order) * std::max<uint32>(queries, 1)),
+        detail::kDiscreteLogarithmMaxBabySteps);
+    return uint32(std::min<uint64>(order, std::max<uint64>(SquareCeiling(order), balanced)));
+  }
+
+  uint32 p_;
+  uint32 order_;
+  uint32 steps_;
+  uint32 giant_step_;
+  FlatHashMap<uint32, uint32> baby_steps_;
+};
+
 /**
  * Calculates discrete logarithm of x in the base of a modulo p.
  *
@@ -422,22 +1278,24 @@ uint32 MultiplicativeOrder(uint32 a, uint32 p) {
  * Also note that a, x, and p are 32 bits unsigned integers.
  */
 uint32 DiscreteLogarithm(const uint32 a, uint32 x, const uint32 p) {
-  const uint32 order_of_a = MultiplicativeOrder(a, p);
-  const uint32 sqrt = uint64(SquareCeiling(p - 1));
-  std::unordered_map<uint32, uint32> small_steps;
-  for (auto i: range<uint32>(0, sqrt))
-    small_steps.emplace(PowerModulo32(a, i, p), i);
-
-  uint32 giant_step = Inverse(PowerModulo32(a, sqrt, p), p);
-
-  for (auto i: range<uint32>(0, sqrt)) {
-    auto it = small_steps.find(x);
-    if (it != small_steps.end()) {
-      return (uint64(it->second) + uint64(i) * sqrt) % order_of_a;
-    }
-    x = Multiply32(x, giant_step, p);
-  }
-  throw std::runtime_error("DiscreteLogarithm - no logarithm found");
+  return DiscreteLogarithmSolver(a, p).logarithm(x);
+}
+
+/**
+ * Calculates discrete logarithms of all xs in the base of a modulo p.
+ *
+ * Baby steps are shared between queries, computational complexity
+ * is O(sqrt(p * xs.size())) as long as table of baby steps fits in memory.
+ *
+ * If some x is not in orbit of a throws an exception of type std::runtime_error.
+ */
+std::vector<uint32> DiscreteLogarithm(const uint32 a, const std::vector<uint32>& xs, const uint32 p) {
+  DiscreteLogarithmSolver solver(a, p, uint32(xs.size()));
+  std::vector<uint32> result;
+  result.reserve(xs.size());
+  for (auto x: xs)
+    result.push_back(solver.logarithm(x));
+  return result;
 }
 
 } // namespace numeric
@@ -0,0 +1,423 @@
+#pragma once
+// Jakub Staroń, 2016
+
+#include "headers.h"
+#include "iterators.h"
+#include "numeric.h"
+#include "numeric/number_theory.h"
+#include "numeric/prime_field.h"
+
+namespace lib {
+namespace numeric {
+
+constexpr uint32 ntt_prime1 = 998244353; // 119 * 2^23 + 1
+constexpr uint32 ntt_prime2 = 167772161; // 5 * 2^25 + 1
+constexpr uint32 ntt_prime3 = 469762049; // 7 * 2^26 + 1
+
+namespace detail {
+
+/**
+ * Precomputed roots of unity modulo prime.
+ *
+ * For every power of two half, roots()[half + j] is
+ * w^j, where w is primitive root of unity of degree 2 * half.
+ * Tables are extended on demand and shared between calls.
+ */
+template <uint32 prime>
+class ntt_roots {
+public:
+  using value_type = prime_field<prime>;
+  static constexpr uint32 kMaxLogSize = least_significant_one(prime - 1);
+
+  static const std::vector<value_type>& roots(size_t size) {
+    return instance().extend(size).roots_;
+  }
+
+  static const std::vector<value_type>& inverse_roots(size_t size) {
+    return instance().extend(size).inverse_roots_;
+  }
+
+private:
+  ntt_roots():
+      generator_(2) {
+    while (!IsPrimitiveRoot(generator_.value(), prime))
+      generator_ += 1;
+    roots_ = {0, 1};
+    inverse_roots_ = {0, 1};
+  }
+
+  static ntt_roots& instance() {
+    static ntt_roots roots;
+    return roots;
+  }
+
+  ntt_roots& extend(size_t size) {
+    if (size > (size_t(1) << kMaxLogSize))
+      throw std::invalid_argument("NumberTheoreticTransform - size too big for prime");
+
+    for (size_t half = roots_.size(); half < size; half *= 2) {
+      const value_type root = power(generator_, (prime - 1) / (2 * half));
+      const value_type inverse_root = inverse(root);
+      roots_.resize(2 * half);
+      inverse_roots_.resize(2 * half);
+      for (size_t j = 0; j < half; j += 2) {
+        roots_[half + j] = roots_[half / 2 + j / 2];
+        roots_[half + j + 1] = roots_[half + j] * root;
+        inverse_roots_[half + j] = inverse_roots_[half / 2 + j / 2];
+        inverse_roots_[half + j + 1] = inverse_roots_[half + j] * inverse_root;
+      }
+    }
+    return *this;
+  }
+
+  value_type generator_;
+  std::vector<value_type> roots_;
+  std::vector<value_type> inverse_roots_;
+};
+
+template <uint32 prime>
+constexpr uint32 ntt_roots<prime>::kMaxLogSize;
+
+/**
+ * Number of elements transformed together when all
+ * butterflies fit in L1 cache.
+ */
+constexpr size_t kTransformBlockSize = 1 << 12;
+
+template <uint32 prime>
+void DecimationInFrequencyStages(prime_field<prime>* values, size_t size, size_t length,
+                                 size_t last_length, const std::vector<prime_field<prime>>& roots) {
+  for (; length >= last_length; length /= 2) {
+    const size_t half = length / 2;
+    for (size_t i = 0; i < size; i += length) {
+      prime_field<prime>* first = values + i;
+      prime_field<prime>* second = first + half;
+      const prime_field<prime>* root = roots.data() + half;
+      for (size_t j = 0; j < half; ++j) {
+        const prime_field<prime> u = first[j];
+        const prime_field<prime> v = second[j];
+        first[j] = u + v;
+        second[j] = (u - v) * root[j];
+      }
+    }
+  }
+}
+
+template <uint32 prime>
+void DecimationInTimeStages(prime_field<prime>* values, size_t size, size_t length,
+                            size_t last_length, const std::vector<prime_field<prime>>& roots) {
+  for (; length <= last_length; length *= 2) {
+    const size_t half = length / 2;
+    for (size_t i = 0; i < size; i += length) {
+      prime_field<prime>* first = values + i;
+      prime_field<prime>* second = first + half;
+      const prime_field<prime>* root = roots.data() + half;
+      for (size_t j = 0; j < half; ++j) {
+        const prime_field<prime> u = first[j];
+        const prime_field<prime> v = second[j] * root[j];
+        first[j] = u + v;
+        second[j] = u - v;
+      }
+    }
+  }
+}
+
+} // namespace detail
+
+/**
+ * Computes number-theoretic transform of values in place.
+ *
+ * Size of values must be power of two and must divide prime - 1.
+ * Result is stored in bit-reversed order, which is fine for
+ * pointwise multiplication followed by InverseNumberTheoreticTransform.
+ *
+ * Stages with butterflies shorter than detail::kTransformBlockSize
+ * are computed block by block, so they work in cache.
+ */
+template <uint32 prime>
+void NumberTheoreticTransform(std::vector<prime_field<prime>>& values) {
+  const size_t size = values.size();
+  if (size <= 1)
+    return;
+  assert((size & (size - 1)) == 0);
+
+  const auto& roots = detail::ntt_roots<prime>::roots(size);
+  const size_t block = std::min(size, detail::kTransformBlockSize);
+  detail::DecimationInFrequencyStages(values.data(), size, size, 2 * block, roots);
+  for (size_t i = 0; i < size; i += block)
+    detail::DecimationInFrequencyStages(values.data() + i, block, block, 2, roots);
+}
+
+/**
+ * Computes inverse of NumberTheoreticTransform in place.
+ *
+ * Takes values in bit-reversed order and returns them in natural order.
+ */
+template <uint32 prime>
+void InverseNumberTheoreticTransform(std::vector<prime_field<prime>>& values) {
+  const size_t size = values.size();
+  if (size <= 1)
+    return;
+  assert((size & (size - 1)) == 0);
+
+  const auto& roots = detail::ntt_roots<prime>::inverse_roots(size);
+  const size_t block = std::min(size, detail::kTransformBlockSize);
+  for (size_t i = 0; i < size; i += block)
+    detail::DecimationInTimeStages(values.data() + i, block, 2, block, roots);
+  detail::DecimationInTimeStages(values.data(), size, 2 * block, size, roots);
+
+  const prime_field<prime> scale = inverse(prime_field<prime>(size));
+  for (auto& value: values)
+    value *= scale;
+}
+
+namespace polynomial {
+
+/**
+ * Polynomial over Z_prime, i-th element is coefficient of x^i.
+ */
+template <uint32 prime>
+using polynomial_type = std::vector<prime_field<prime>>;
+
+namespace detail {
+
+constexpr size_t kSchoolbookThreshold = 32;
+
+template <uint32 prime>
+polynomial_type<prime> Truncate(const polynomial_type<prime>& a, size_t n) {
+  polynomial_type<prime> result(n);
+  std::copy(a.begin(), a.begin() + std::min(n, a.size()), result.begin());
+  return result;
+}
+
+size_t TransformSize(size_t size) {
+  size_t result = 1;
+  while (result < size)
+    result *= 2;
+  return result;
+}
+
+} // namespace detail
+
+/**
+ * Returns product of polynomials a and b.
+ *
+ * Uses number-theoretic transform, so prime - 1 must be divisible
+ * by power of two not smaller than a.size() + b.size() - 1,
+ * eg ntt_prime1. Computational complexity is O(n log n).
+ */
+template <uint32 prime>
+polynomial_type<prime> Multiply(const polynomial_type<prime>& a, const polynomial_type<prime>& b) {
+  if (a.empty() || b.empty())
+    return {};
+
+  const size_t result_size = a.size() + b.size() - 1;
+  if (std::min(a.size(), b.size()) <= detail::kSchoolbookThreshold) {
+    polynomial_type<prime> result(result_size);
+    for (auto i: range<size_t>(0, a.size()))
+      for (auto j: range<size_t>(0, b.size()))
+        result[i + j] += a[i] * b[j];
+    return result;
+  }
+
+  const size_t size = detail::TransformSize(result_size);
+  polynomial_type<prime> fa = detail::Truncate(a, size);
+  polynomial_type<prime> fb = detail::Truncate(b, size);
+  NumberTheoreticTransform(fa);
+  NumberTheoreticTransform(fb);
+  for (auto i: range<size_t>(0, size))
+    fa[i] *= fb[i];
+  InverseNumberTheoreticTransform(fa);
+  fa.resize(result_size);
+  return fa;
+}
+
+/**
+ * Returns first n coefficients of 1/a.
+ *
+ * Throws std::invalid_argument if a(0) is 0.
+ * Computational complexity is O(n log n).
+ */
+template <uint32 prime>
+polynomial_type<prime> Inverse(const polynomial_type<prime>& a, size_t n) {
+  if (a.empty() || a[0] == 0)
+    throw std::invalid_argument("polynomial::Inverse - constant term is zero");
+
+  polynomial_type<prime> result = {inverse(a[0])};
+  for (size_t length = 1; length < n; length *= 2) {
+    const size_t size = 4 * length;
+    polynomial_type<prime> fa = detail::Truncate(a, 2 * length);
+    polynomial_type<prime> fb = detail::Truncate(result, 2 * length);
+    fa.resize(size);
+    fb.resize(size);
+    NumberTheoreticTransform(fa);
+    NumberTheoreticTransform(fb);
+    for (auto i: range<size_t>(0, size))
+      fa[i] = fb[i] * (2 - fa[i] * fb[i]);
+    InverseNumberTheoreticTransform(fa);
+    fa.resize(2 * length);
+    result = std::move(fa);
+  }
+  result.resize(n);
+  return result;
+}
+
+/**
+ * Returns derivative of a.
+ */
+template <uint32 prime>
+polynomial_type<prime> Derivative(const polynomial_type<prime>& a) {
+  if (a.empty())
+    return {};
+  polynomial_type<prime> result(a.size() - 1);
+  for (auto i: range<size_t>(1, a.size()))
+    result[i - 1] = a[i] * i;
+  return result;
+}
+
+/**
+ * Returns integral of a with constant term equal to 0.
+ *
+ * Inverses of 1, 2, ..., a.size() are computed in linear time.
+ */
+template <uint32 prime>
+polynomial_type<prime> Integral(const polynomial_type<prime>& a) {
+  polynomial_type<prime> inverses(a.size() + 1);
+  if (a.size() > 0)
+    inverses[1] = 1;
+  for (size_t i = 2; i <= a.size(); ++i)
+    inverses[i] = -int64(prime / i) * inverses[prime % i];
+
+  polynomial_type<prime> result(a.size() + 1);
+  for (auto i: range<size_t>(0, a.size()))
+    result[i + 1] = a[i] * inverses[i + 1];
+  return result;
+}
+
+/**
+ * Returns first n coefficients of ln(a).
+ *
+ * Throws std::invalid_argument if a(0) is not 1.
+ */
+template <uint32 prime>
+polynomial_type<prime> Logarithm(const polynomial_type<prime>& a, size_t n) {
+  if (a.empty() || a[0] != 1)
+    throw std::invalid_argument("polynomial::Logarithm - constant term is not one");
+  if (n == 0)
+    return {};
+
+  polynomial_type<prime> result = Multiply(Derivative(detail::Truncate(a, n)), Inverse(a, n));
+  result.resize(n - 1);
+  result = Integral(result);
+  return result;
+}
+
+/**
+ * Returns first n coefficients of exp(a).
+ *
+ * Throws std::invalid_argument if a(0) is not 0.
+ */
+template <uint32 prime>
+polynomial_type<prime> Exponent(const polynomial_type<prime>& a, size_t n) {
+  if (!a.empty() && a[0] != 0)
+    throw std::invalid_argument("polynomial::Exponent - constant term is not zero");
+
+  polynomial_type<prime> result = {1};
+  for (size_t length = 1; length < n; length *= 2) {
+    polynomial_type<prime> difference = detail::Truncate(a, 2 * length);
+    const polynomial_type<prime> logarithm = Logarithm(result, 2 * length);
+    for (auto i: range<size_t>(0, 2 * length))
+      difference[i] -= logarithm[i];
+    difference[0] += 1;
+    result = Multiply(result, difference);
+    result.resize(2 * length);
+  }
+  result.resize(n);
+  return result;
+}
+
+/**
+ * Returns first n coefficients of a^k.
+ */
+template <uint32 prime>
+polynomial_type<prime> Power(const polynomial_type<prime>& a, uint64 k, size_t n) {
+  polynomial_type<prime> result(n);
+  if (k == 0) {
+    if (n > 0)
+      result[0] = 1;
+    return result;
+  }
+
+  size_t shift = 0;
+  while (shift < a.size() && a[shift] == 0)
+    shift++;
+  if (shift == a.size() || (shift > 0 && k >= (n + shift - 1) / shift))
+    return result;
+
+  const size_t length = n - shift * k;
+  const prime_field<prime> leading = a[shift];
+  const prime_field<prime> leading_inverse = inverse(leading);
+  polynomial_type<prime> normalized(a.begin() + shift, a.begin() + std::min(a.size(), shift + length));
+  for (auto& coefficient: normalized)
+    coefficient *= leading_inverse;
+
+  polynomial_type<prime> logarithm = Logarithm(normalized, length);
+  for (auto& coefficient: logarithm)
+    coefficient *= k;
+  const polynomial_type<prime> exponent = Exponent(logarithm, length);
+
+  const prime_field<prime> scale = power(leading, k);
+  for (auto i: range<size_t>(0, length))
+    result[shift * k + i] = exponent[i] * scale;
+  return result;
+}
+
+/**
+ * Returns product of polynomials a and b modulo arbitrary modulo.
+ *
+ * Coefficients don't have to be reduced, they are reduced modulo modulo
+ * first. Then polynomials are multiplied modulo three NTT primes and results
+ * are merged using Chinese remainder theorem. Result is exact when
+ * min(a.size(), b.size()) * (modulo - 1)^2 is smaller than
+ * ntt_prime1 * ntt_prime2 * ntt_prime3 (about 7.8 * 10^25).
+ *
+ * Throws an std::invalid_argument if modulo is 0.
+ */
+std::vector<uint32> MultiplyModulo(std::vector<uint32> a, std::vector<uint32> b, uint32 modulo) {
+  if (modulo == 0)
+    throw std::invalid_argument("polynomial::MultiplyModulo - modulo must be positive");
+  if (a.empty() || b.empty())
+    return {};
+  for (auto& value: a)
+    value %= modulo;
+  for (auto& value: b)
+    value %= modulo;
+
+  using field2 = prime_field<ntt_prime2>;
+  using field3 = prime_field<ntt_prime3>;
+
+  const auto result1 = Multiply(polynomial_type<ntt_prime1>(a.begin(), a.end()),
+                                polynomial_type<ntt_prime1>(b.begin(), b.end()));
+  const auto result2 = Multiply(polynomial_type<ntt_prime2>(a.begin(), a.end()),
+                                polynomial_type<ntt_prime2>(b.begin(), b.end()));
+  const auto result3 = Multiply(polynomial_type<ntt_prime3>(a.begin(), a.end()),
+                                polynomial_type<ntt_prime3>(b.begin(), b.end()));
+
+  const field2 inverse12 = inverse(field2(ntt_prime1));
+  const field3 inverse123 = inverse(field3(ntt_prime1) * field3(ntt_prime2));
+  const uint64 product12 = uint64(ntt_prime1) * uint64(ntt_prime2) % modulo;
+
+  std::vector<uint32> result(result1.size());
+  for (auto i: range<size_t>(0, result.size())) {
+    const uint32 x1 = result1[i].value();
+    const uint32 x2 = ((field2(result2[i].value()) - x1) * inverse12).value();
+    const uint32 x3 = ((field3(result3[i].value()) - x1 - field3(x2) * ntt_prime1) * inverse123).value();
+    result[i] = uint32((x1 + uint64(x2) * ntt_prime1 % modulo + uint64(x3) * product12) % modulo);
+  }
+  return result;
+}
+
+} // namespace polynomial
+
+} // namespace numeric
+} // namespace lib
@@ -25,6 +25,19 @@ prime_field<prime> power(prime_field<prime> a, uint64 n);
 template<uint32 prime>
 prime_field<prime> inverse(const prime_field<prime>& lhs);
 
+/**
+ * Replaces every element of [first, last) with its inverse.
+ *
+ * Uses Montgomery's trick, so only one inverse is computed
+ * and the rest costs 3 multiplications per element.
+ * Works for any field type with inverse function (ie also for montgomery_field),
+ * Iterator must be bidirectional.
+ *
+ * Throws an std::runtime_error if some element is not inversible (ie is 0).
+ */
+template <typename Iterator>
+void batch_inverse(Iterator first, Iterator last);
+
 template<uint32 prime>
 std::ostream& operator<<(std::ostream& stream, const prime_field<prime>& lhs);
 
@@ -137,6 +150,25 @@ prime_field<prime> inverse(const prime_field<prime>& lhs) {
   return power(lhs, prime - 2);
 }
 
+template <typename Iterator>
+void batch_inverse(Iterator first, Iterator last) {
+  using field = typename std::iterator_traits<Iterator>::value_type;
+  std::vector<field> prefix;
+  field product = 1;
+  for (Iterator it = first; it != last; ++it) {
+    prefix.push_back(product);
+    product *= *it;
+  }
+
+  field inversed = inverse(product);
+  for (size_t i = prefix.size(); i-- > 0;) {
+    --last;
+    const field value = *last;
+    *last = inversed * prefix[i];
+    inversed *= value;
+  }
+}
+
 template<uint32 prime>
 void prime_field<prime>::operator+=(const prime_field<prime>& rhs) {
   *this = *this + rhs;
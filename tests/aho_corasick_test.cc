@@ -0,0 +1,82 @@
+// Jakub Staroń, 2016
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+#include "text_algorithms/aho_corasick.h"
+
+using namespace lib;
+
+BOOST_AUTO_TEST_SUITE(aho_corasick_test)
+
+using Match = std::pair<uint32, uint64>;
+
+std::vector<Match> NaiveMatches(const std::vector<std::string>& patterns, const std::string& text) {
+  std::vector<Match> result;
+  for (uint32 p = 0; p < patterns.size(); p++)
+    for (size_t i = 0; i + patterns[p].size() <= text.size(); i++)
+      if (text.compare(i, patterns[p].size(), patterns[p]) == 0)
+        result.emplace_back(p, i);
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
+std::vector<Match> Matches(const AhoCorasick& automaton, const std::string& text) {
+  std::vector<Match> result;
+  automaton.find(text.begin(), text.end(), [&result](uint32 pattern, uint64 offset) {
+    result.emplace_back(pattern, offset);
+  });
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
+BOOST_AUTO_TEST_CASE(aho_corasick_test) {
+  std::vector<std::string> patterns = {"he", "she", "his", "hers", "he"};
+  std::string text = "ushers and his hershey";
+  for (uint32 dense_alphabet: {0u, AhoCorasick::kDenseAlphabetSize}) {
+    AhoCorasick automaton(patterns.begin(), patterns.end(), dense_alphabet);
+    BOOST_CHECK_EQUAL(automaton.dense(), dense_alphabet > 0);
+    BOOST_CHECK_EQUAL(automaton.patterns(), 5);
+    BOOST_CHECK_EQUAL(automaton.size(), 10);
+    BOOST_CHECK_EQUAL(automaton.count(text.begin(), text.end()), 11);
+    BOOST_CHECK(Matches(automaton, text) == NaiveMatches(patterns, text));
+    std::string empty;
+    BOOST_CHECK_EQUAL(automaton.count(empty.begin(), empty.end()), 0);
+  }
+
+  std::vector<std::string> with_empty = {"a", ""};
+  BOOST_CHECK_THROW(AhoCorasick(with_empty.begin(), with_empty.end()), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(random_test) {
+  for (int test = 0; test < 100; test++) {
+    const uint32 alphabet = 2 + Random32() % 4;
+    std::vector<std::string> patterns(1 + Random32() % 20);
+    for (auto& pattern: patterns)
+      for (uint32 i = 1 + Random32() % 5; i > 0; i--)
+        pattern += char('a' + Random32() % alphabet);
+    std::string text;
+    for (uint32 i = Random32() % 500; i > 0; i--)
+      text += char('a' + Random32() % (alphabet + 1));
+
+    const auto expected = NaiveMatches(patterns, text);
+    for (uint32 dense_alphabet: {0u, 256u}) {
+      AhoCorasick automaton(patterns.begin(), patterns.end(), dense_alphabet);
+      BOOST_CHECK_EQUAL(automaton.count(text.begin(), text.end()), expected.size());
+      BOOST_CHECK(Matches(automaton, text) == expected);
+    }
+  }
+
+  // wide nodes use binary search of edges
+  std::vector<std::string> patterns;
+  for (int c = 0; c < 256; c++)
+    patterns.push_back(std::string(1, char(c)) + char(255 - c));
+  std::string text;
+  for (int i = 0; i < 10000; i++)
+    text += char(Random32());
+  AhoCorasick automaton(patterns.begin(), patterns.end());
+  BOOST_CHECK(!automaton.dense());
+  BOOST_CHECK(Matches(automaton, text) == NaiveMatches(patterns, text));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
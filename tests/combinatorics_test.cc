@@ -0,0 +1,55 @@
+// Jakub Staroń, 2016
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+#include "numeric/combinatorics.h"
+
+
+using namespace lib;
+using namespace lib::numeric;
+
+BOOST_AUTO_TEST_SUITE(combinatorics_test)
+
+constexpr uint32 kPrime = 1000 * 1000 * 1000 + 7;
+
+BOOST_AUTO_TEST_CASE(factorial_test) {
+  Combinatorics<kPrime> combinatorics(100);
+  BOOST_CHECK_EQUAL(combinatorics.size(), 100);
+  BOOST_CHECK_EQUAL(combinatorics.factorial(0), 1);
+  BOOST_CHECK_EQUAL(combinatorics.factorial(1), 1);
+  BOOST_CHECK_EQUAL(combinatorics.factorial(10), 3628800);
+  BOOST_CHECK_EQUAL(combinatorics.factorial(20), 146326063);
+  for (uint32 n = 0; n <= 100; n++)
+    BOOST_CHECK_EQUAL(combinatorics.factorial(n) * combinatorics.inverseFactorial(n), 1);
+}
+
+BOOST_AUTO_TEST_CASE(inverse_test) {
+  Combinatorics<kPrime> combinatorics(10000);
+  for (uint32 n = 1; n <= 10000; n++)
+    BOOST_CHECK_EQUAL(combinatorics.inverse(n), inverse(prime_field<kPrime>(n)));
+
+  Combinatorics<13> small(12);
+  for (uint32 n = 1; n <= 12; n++)
+    BOOST_CHECK_EQUAL(small.inverse(n) * n, 1);
+  BOOST_CHECK_EQUAL(small.factorial(12), 12); // Wilson theorem
+  BOOST_CHECK_THROW(Combinatorics<13>(13), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(binomial_test) {
+  Combinatorics<kPrime> combinatorics(1000);
+  BOOST_CHECK_EQUAL(combinatorics.binomial(0, 0), 1);
+  BOOST_CHECK_EQUAL(combinatorics.binomial(5, 2), 10);
+  BOOST_CHECK_EQUAL(combinatorics.binomial(5, 6), 0);
+  BOOST_CHECK_EQUAL(combinatorics.binomial(1000, 500), 159835829);
+  BOOST_CHECK_EQUAL(combinatorics.permutations(5, 2), 20);
+  BOOST_CHECK_EQUAL(combinatorics.permutations(5, 6), 0);
+
+  // Pascal triangle
+  for (uint32 n = 1; n <= 200; n++)
+    for (uint32 k = 1; k <= n; k++)
+      BOOST_CHECK_EQUAL(combinatorics.binomial(n, k),
+          combinatorics.binomial(n - 1, k - 1) + combinatorics.binomial(n - 1, k));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
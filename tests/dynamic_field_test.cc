@@ -0,0 +1,103 @@
+// Jakub Staroń, 2016
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+#include "numeric.h"
+#include "numeric/prime_field.h"
+#include "numeric/dynamic_field.h"
+#include "io.h"
+
+using namespace lib;
+
+BOOST_AUTO_TEST_SUITE(dynamic_field_suite)
+
+struct small_tag { };
+struct big_tag { };
+
+using small_field = numeric::dynamic_field<small_tag>;
+using big_field = numeric::dynamic_field<big_tag>;
+
+BOOST_AUTO_TEST_CASE(creation_test) {
+  small_field::setPrime(5);
+  BOOST_CHECK_EQUAL(small_field::prime(), 5);
+  BOOST_CHECK_EQUAL(small_field(10).value(), 0);
+  BOOST_CHECK_EQUAL(small_field(4).value(), 4);
+  BOOST_CHECK_EQUAL(small_field(-1).value(), 4);
+  BOOST_CHECK_EQUAL(small_field((1uLL << 63) + uint64(1000 * 1000 * 1000)).value(), 3);
+
+  big_field::setPrime(uint32_prime1);
+  BOOST_CHECK_EQUAL(big_field(uint64(uint32_prime1) * uint64(uint32_prime1) + 100).value(), 100);
+  BOOST_CHECK_EQUAL(big_field(-int64(uint32_prime1) - int64(uint32_prime1) - 10), -10);
+
+  BOOST_CHECK_THROW(small_field::setPrime(4), std::invalid_argument);
+  BOOST_CHECK_THROW(small_field::setPrime(1), std::invalid_argument);
+  BOOST_CHECK_THROW(small_field::setPrime(0), std::invalid_argument);
+  BOOST_CHECK_EQUAL(small_field::prime(), 5);
+}
+
+BOOST_AUTO_TEST_CASE(arithmetic_test) {
+  small_field::setPrime(7);
+  small_field a = 3, b = 5;
+  BOOST_CHECK_EQUAL(a + b, 1);
+  BOOST_CHECK_EQUAL(a - b, 5);
+  BOOST_CHECK_EQUAL(a * b, 1);
+  BOOST_CHECK_EQUAL(a / b, 2);
+  BOOST_CHECK_EQUAL(inverse(a), 5);
+  BOOST_CHECK_EQUAL(power(a, 6), 1);
+  BOOST_CHECK_EQUAL(power(a, 0), 1);
+  BOOST_CHECK_EQUAL(power(small_field(0), 5), 0);
+  BOOST_CHECK_THROW(inverse(small_field(7)), std::runtime_error);
+
+  a += b;
+  BOOST_CHECK_EQUAL(a, 1);
+  a -= b;
+  BOOST_CHECK_EQUAL(a, 3);
+  a *= b;
+  BOOST_CHECK_EQUAL(a, 1);
+  a /= b;
+  BOOST_CHECK_EQUAL(a, 3);
+  BOOST_CHECK(a != b);
+  BOOST_CHECK(a == small_field(10));
+}
+
+BOOST_AUTO_TEST_CASE(io_test) {
+  small_field::setPrime(5);
+  {
+    std::ostringstream stream;
+    stream << small_field(9);
+    BOOST_CHECK_EQUAL(stream.str(), "4");
+  }
+
+  {
+    std::istringstream stream("-1");
+    small_field a;
+    stream >> a;
+    BOOST_CHECK_EQUAL(a, 4);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(compatibility_with_prime_field_test) {
+  constexpr uint32 kPrime = 1000 * 1000 * 1000 + 7;
+  using field = numeric::prime_field<kPrime>;
+  using wide_field = numeric::prime_field<uint32_prime1>;
+  small_field::setPrime(kPrime);
+  big_field::setPrime(uint32_prime1);
+
+  auto check = [](uint32 a, uint32 b) {
+    BOOST_CHECK_EQUAL((small_field(a) + small_field(b)).value(), (field(a) + field(b)).value());
+    BOOST_CHECK_EQUAL((small_field(a) - small_field(b)).value(), (field(a) - field(b)).value());
+    BOOST_CHECK_EQUAL((small_field(a) * small_field(b)).value(), (field(a) * field(b)).value());
+    BOOST_CHECK_EQUAL(power(small_field(a), b).value(), power(field(a), b).value());
+    BOOST_CHECK_EQUAL((big_field(a) * big_field(b)).value(), (wide_field(a) * wide_field(b)).value());
+    BOOST_CHECK_EQUAL((big_field(a) - big_field(b)).value(), (wide_field(a) - wide_field(b)).value());
+  };
+
+  check(0, 0);
+  check(kPrime - 1, kPrime - 1);
+  check(uint32_prime1 - 1, uint32_prime1 - 1);
+  for (auto i: range<uint32>(0, 1000))
+    check(Random32(), Random32());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,87 @@
+// Jakub Staroń, 2016
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+#include "data_structures/flat_hash_map.h"
+
+
+using namespace lib;
+
+BOOST_AUTO_TEST_SUITE(flat_hash_map_test)
+
+BOOST_AUTO_TEST_CASE(empty) {
+  FlatHashMap<int, int> map;
+  BOOST_CHECK_EQUAL(map.size(), 0);
+  BOOST_CHECK_EQUAL(map.empty(), true);
+  BOOST_CHECK(map.find(5) == nullptr);
+  BOOST_CHECK_EQUAL(map.erase(5), false);
+}
+
+BOOST_AUTO_TEST_CASE(insert_find) {
+  FlatHashMap<uint32, uint32> map;
+  BOOST_CHECK_EQUAL(map.insert(5, 10), true);
+  BOOST_CHECK_EQUAL(map.insert(5, 11), false);
+  BOOST_CHECK_EQUAL(*map.find(5), 10);
+  BOOST_CHECK(map.find(6) == nullptr);
+  BOOST_CHECK_EQUAL(map.contains(5), true);
+  BOOST_CHECK_EQUAL(map.contains(6), false);
+  map[6] = 12;
+  map[5]++;
+  BOOST_CHECK_EQUAL(*map.find(5), 11);
+  BOOST_CHECK_EQUAL(*map.find(6), 12);
+  BOOST_CHECK_EQUAL(map.size(), 2);
+  map.clear();
+  BOOST_CHECK_EQUAL(map.empty(), true);
+  BOOST_CHECK(map.find(5) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(rehash) {
+  FlatHashMap<uint32, uint32> map;
+  for (uint32 i = 0; i < 10000; i++)
+    map.insert(i * 1024, i);
+  BOOST_CHECK_EQUAL(map.size(), 10000);
+  for (uint32 i = 0; i < 10000; i++)
+    BOOST_CHECK_EQUAL(*map.find(i * 1024), i);
+
+  uint64 sum = 0;
+  map.forEach([&](uint32, uint32 value) { sum += value; });
+  BOOST_CHECK_EQUAL(sum, 9999uLL * 10000 / 2);
+}
+
+BOOST_AUTO_TEST_CASE(string_keys) {
+  FlatHashMap<std::string, int> map;
+  map["ala"] = 1;
+  map["ma"] = 2;
+  map["kota"] = 3;
+  BOOST_CHECK_EQUAL(*map.find("ma"), 2);
+  BOOST_CHECK_EQUAL(map.erase("ma"), true);
+  BOOST_CHECK(map.find("ma") == nullptr);
+  BOOST_CHECK_EQUAL(*map.find("kota"), 3);
+}
+
+BOOST_AUTO_TEST_CASE(random_operations) {
+  FlatHashMap<uint32, uint32> map;
+  std::unordered_map<uint32, uint32> expected;
+  for (uint32 i = 0; i < 200000; i++) {
+    // small key range forces long probe sequences and many erasures
+    const uint32 key = Random32() % 2048;
+    switch (Random32() % 3) {
+      case 0:
+        BOOST_CHECK_EQUAL(map.insert(key, i), expected.emplace(key, i).second);
+        break;
+      case 1:
+        BOOST_CHECK_EQUAL(map.erase(key), expected.erase(key) == 1);
+        break;
+      default:
+        auto it = expected.find(key);
+        const uint32* value = map.find(key);
+        BOOST_CHECK_EQUAL(value != nullptr, it != expected.end());
+        if (value != nullptr && it != expected.end())
+          BOOST_CHECK_EQUAL(*value, it->second);
+    }
+    BOOST_CHECK_EQUAL(map.size(), expected.size());
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,85 @@
+// Jakub Staroń, 2016
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+#include "text_algorithms/fm_index.h"
+
+using namespace lib;
+
+BOOST_AUTO_TEST_SUITE(fm_index_test)
+
+std::vector<uint32> NaiveLocate(const std::string& text, const std::string& pattern) {
+  std::vector<uint32> result;
+  for (size_t position = text.find(pattern); position != std::string::npos; position = text.find(pattern, position + 1))
+    result.push_back(uint32(position));
+  return result;
+}
+
+BOOST_AUTO_TEST_CASE(simple_test) {
+  FMIndex index("abracadabra");
+  BOOST_CHECK_EQUAL(index.size(), 11);
+  BOOST_CHECK_EQUAL(index.count("abra"), 2);
+  BOOST_CHECK_EQUAL(index.count("a"), 5);
+  BOOST_CHECK_EQUAL(index.count("abracadabra"), 1);
+  BOOST_CHECK_EQUAL(index.count("abracadabraa"), 0);
+  BOOST_CHECK_EQUAL(index.count("x"), 0);
+  BOOST_CHECK_EQUAL(index.count(""), 12);
+  BOOST_CHECK(index.locate("abra") == std::vector<uint32>({0, 7}));
+  BOOST_CHECK(index.locate("cad") == std::vector<uint32>({4}));
+  BOOST_CHECK(index.locate("rab").empty());
+
+  std::list<char> pattern = {'b', 'r'};
+  BOOST_CHECK_EQUAL(index.count(pattern.begin(), pattern.end()), 2);
+
+  FMIndex empty("");
+  BOOST_CHECK_EQUAL(empty.size(), 0);
+  BOOST_CHECK_EQUAL(empty.count("a"), 0);
+  BOOST_CHECK_EQUAL(empty.count(""), 1);
+
+  BOOST_CHECK_THROW(FMIndex("abc", 0), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(all_bytes_test) {
+  std::string text;
+  for (int repeat = 0; repeat < 3; repeat++)
+    for (int byte = 0; byte < 256; byte++)
+      text += char(byte);
+  FMIndex index(text, 5);
+  for (int byte = 0; byte < 256; byte++) {
+    const std::string pattern(1, char(byte));
+    BOOST_CHECK_EQUAL(index.count(pattern), 3);
+    BOOST_CHECK(index.locate(pattern) == NaiveLocate(text, pattern));
+  }
+  BOOST_CHECK_EQUAL(index.count("\xfe\xff"), 3);
+  BOOST_CHECK_EQUAL(index.count(std::string("\xff\x00", 2)), 2);
+  BOOST_CHECK_EQUAL(index.count(text), 1);
+}
+
+BOOST_AUTO_TEST_CASE(random_test) {
+  for (uint32 alphabet: {1, 2, 4, 200}) {
+    for (uint32 sample_rate: {1, 3, 32}) {
+      std::string text;
+      for (int i = 0; i < 500; i++)
+        text += char(Random32() % alphabet + 1);
+      std::vector<char> vector(text.begin(), text.end());
+      FMIndex index(vector.begin(), vector.end(), sample_rate);
+      for (int i = 0; i < 300; i++) {
+        std::string pattern;
+        if (i % 2 == 0) {
+          const uint32 begin = Random32() % text.size();
+          pattern = text.substr(begin, Random32() % 8 + 1);
+        }
+        else {
+          for (uint32 length = Random32() % 4 + 1; length > 0; length--)
+            pattern += char(Random32() % (alphabet + 1) + 1);
+        }
+        const auto positions = NaiveLocate(text, pattern);
+        BOOST_CHECK_EQUAL(index.count(pattern), positions.size());
+        BOOST_CHECK(index.locate(pattern) == positions);
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
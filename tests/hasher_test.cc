@@ -71,4 +71,164 @@ BOOST_AUTO_TEST_CASE(hasher_test) {
   }
 }
 
+BOOST_AUTO_TEST_CASE(mersenne61_test) {
+  using backend = hash::mersenne61;
+  const uint64 modulo = backend::kModulo;
+  BOOST_CHECK(backend::base() < modulo);
+  BOOST_CHECK_EQUAL(backend::base(), backend::base());
+  BOOST_CHECK_EQUAL(backend::multiply(modulo - 1, modulo - 1), 1);
+  BOOST_CHECK_EQUAL(backend::multiply(uint64(1) << 60, uint64(2)), 1);
+  BOOST_CHECK_EQUAL(backend::multiply(backend::base(), backend::inverse(backend::base())), 1);
+  BOOST_CHECK_EQUAL(backend::add(modulo - 1, 1), 0);
+  BOOST_CHECK_EQUAL(backend::subtract(0, 1), modulo - 1);
+  for (int i = 0; i < 1000; i++) {
+    const uint64 a = Random64() % modulo, b = Random64() % modulo;
+    // (a * b) mod (2^61 - 1) by double-and-add
+    uint64 expected = 0, power = a;
+    for (uint64 n = b; n > 0; n /= 2) {
+      if (n % 2 == 1)
+        expected = backend::add(expected, power);
+      power = backend::add(power, power);
+    }
+    BOOST_CHECK_EQUAL(backend::multiply(a, b), expected);
+  }
+
+  BOOST_CHECK_EQUAL(hash::hash<backend>(""), backend::zero());
+  BOOST_CHECK(hash::hash<backend>("Ala") == hash::hash<backend>(std::string("Ala")));
+  BOOST_CHECK(hash::hash<backend>("Ala") != hash::hash<backend>("ma"));
+}
+
+BOOST_AUTO_TEST_CASE(mersenne61_hasher_test) {
+  using backend = hash::mersenne61;
+  {
+    std::string text = "";
+    BasicHasher<backend> hasher(text.begin(), text.end());
+    BOOST_CHECK_EQUAL(hasher.getHash(0, 0), hash::hash<backend>(""));
+  }
+
+  {
+    std::string text = "ababaabab";
+    BasicHasher<backend> hasher(text.begin(), text.end());
+    BOOST_CHECK_EQUAL(hasher.getHash(0, 2), hasher.getHash(2, 2));
+    BOOST_CHECK(hasher.getHash(0, 2) != hasher.getHash(1, 2));
+    BOOST_CHECK_EQUAL(hasher.getHash(0, 4), hasher.getHash(5, 4));
+    BOOST_CHECK(hasher.getHash(0, 3) != hasher.getHash(6, 3));
+    BOOST_CHECK_EQUAL(hasher.getHash(5, 3), hash::hash<backend>("aba"));
+    BOOST_CHECK_EQUAL(hasher.getHash(3, 4), hash::hash<backend>("baab"));
+  }
+
+  {
+    // longer text extends shared table of inverses
+    std::string text(100000, 'a');
+    text += "b";
+    BasicHasher<backend> hasher(text.begin(), text.end());
+    BOOST_CHECK_EQUAL(hasher.getHash(0, 1000), hasher.getHash(99000, 1000));
+    BOOST_CHECK(hasher.getHash(0, 1000) != hasher.getHash(99001, 1000));
+    BOOST_CHECK_EQUAL(hasher.getHash(99998, 3), hash::hash<backend>("aab"));
+
+    BasicHasher<backend> moved(std::move(hasher));
+    BOOST_CHECK_EQUAL(moved.getHash(99998, 3), hash::hash<backend>("aab"));
+  }
+}
+
+template <typename Backend, typename Mode>
+void CheckEqual(const std::string& text) {
+  BasicHasher<Backend, Mode> hasher(text.begin(), text.end());
+  for (uint32 begin1 = 0; begin1 <= text.size(); begin1++)
+    for (uint32 begin2 = 0; begin2 <= text.size(); begin2++)
+      for (uint32 length = 0; length + std::max(begin1, begin2) <= text.size(); length++) {
+        const bool expected = text.compare(begin1, length, text, begin2, length) == 0;
+        BOOST_CHECK_EQUAL(hasher.equal(begin1, begin2, length), expected);
+        BOOST_CHECK_EQUAL(hasher.getHash(begin1, length) == hasher.getHash(begin2, length), expected);
+      }
+}
+
+BOOST_AUTO_TEST_CASE(inverse_free_test) {
+  {
+    std::string text = "ababaabab";
+    BasicHasher<hash::prime_pair, hash::inverse_free> hasher(text.begin(), text.end());
+    BOOST_CHECK(hasher.getHash(0, 0) == hash::zero);
+    BOOST_CHECK(hasher.getHash(5, 3) == hash::hash("aba"));
+    BOOST_CHECK(hasher.getHash(3, 4) == hash::hash("baab"));
+    BOOST_CHECK(hasher.getHash(0, 2) == hash::hash("ba"));
+    BOOST_CHECK(hasher.getHash(6, 3) == hash::hash("bab"));
+  }
+
+  {
+    using backend = hash::mersenne61;
+    std::string text = "abcdefgh";
+    BasicHasher<backend, hash::inverse_free> hasher(text.begin(), text.end());
+    BOOST_CHECK_EQUAL(hasher.getHash(2, 3), hash::hash<backend>("edc"));
+    BOOST_CHECK_EQUAL(hasher.getHash(0, 8), hash::hash<backend>("hgfedcba"));
+  }
+
+  CheckEqual<hash::prime_pair, hash::compatible>("ababaababaaabbabab");
+  CheckEqual<hash::prime_pair, hash::inverse_free>("ababaababaaabbabab");
+  CheckEqual<hash::mersenne61, hash::compatible>("aabaabaaabaabbbaab");
+  CheckEqual<hash::mersenne61, hash::inverse_free>("aabaabaaabaabbbaab");
+}
+
+template <typename Backend>
+typename Backend::hash_type NaiveHash(const std::string& text) {
+  typename Backend::hash_type result = Backend::zero(), power = Backend::one();
+  for (char c: text) {
+    result = Backend::add(result, Backend::multiply(power, hash::scalar_type(c)));
+    power = Backend::multiply(power, Backend::base());
+  }
+  return result;
+}
+
+template <typename Backend>
+void CheckBulk() {
+  std::string text;
+  for (int i = 0; i < 5003; i++)
+    text += char(Random32());
+
+  for (size_t length: {0, 1, 7, 8, 9, 1023, 1024, 1025, 5003})
+    BOOST_CHECK(hash::hash<Backend>(text.substr(0, length)) == NaiveHash<Backend>(text.substr(0, length)));
+
+  std::vector<hash::scalar_type> values(text.begin(), text.end());
+  auto power = Backend::one(), generic_power = Backend::one();
+  BOOST_CHECK(Backend::accumulate(values.data(), values.size(), power) ==
+      hash::detail::AccumulateHash<Backend>(values.data(), values.size(), generic_power));
+  BOOST_CHECK(power == generic_power);
+
+  BasicHasher<Backend, hash::compatible> compatible(text.begin(), text.end());
+  BasicHasher<Backend, hash::inverse_free> inverse_free(text.begin(), text.end());
+  for (int i = 0; i < 1000; i++) {
+    const uint32 begin = Random32() % text.size();
+    const uint32 length = Random32() % (text.size() - begin + 1);
+    const std::string substring = text.substr(begin, length);
+    BOOST_CHECK(compatible.getHash(begin, length) == hash::hash<Backend>(substring));
+    BOOST_CHECK(inverse_free.getHash(begin, length) ==
+        hash::hash<Backend>(std::string(substring.rbegin(), substring.rend())));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(powers_table_test) {
+  using backend = hash::mersenne61;
+  std::weak_ptr<const std::vector<uint64>> table;
+  {
+    auto powers = detail::BasePowers<backend, false>(1000);
+    BOOST_CHECK_GE(powers->size(), 1000u);
+    BOOST_CHECK_EQUAL((*powers)[999], backend::multiply((*powers)[998], backend::base()));
+    BOOST_CHECK((detail::BasePowers<backend, false>(10) == powers));
+    table = powers;
+  }
+  // table is freed with the last hasher using it
+  BOOST_CHECK(table.expired());
+  BOOST_CHECK_EQUAL((detail::BasePowers<backend, false>(5)->size()), 5u);
+
+  // compatible hasher keeps only powers of inverse of base
+  const std::string text(1000, 'a');
+  BasicHasher<backend> hasher(text.begin(), text.end());
+  BOOST_CHECK_EQUAL((detail::BasePowers<backend, false>(1)->size()), 1u);
+  BOOST_CHECK_GE((detail::BasePowers<backend, true>(1)->size()), 1001u);
+}
+
+BOOST_AUTO_TEST_CASE(bulk_construction_test) {
+  CheckBulk<hash::prime_pair>();
+  CheckBulk<hash::mersenne61>();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
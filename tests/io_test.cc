@@ -147,6 +147,45 @@ BOOST_AUTO_TEST_CASE(print_test) {
   }
 }
 
+BOOST_AUTO_TEST_CASE(print_compile_time_format_test) {
+  {
+    std::ostringstream stream;
+    print(stream, LIB_FORMAT(""));
+    BOOST_CHECK_EQUAL(stream.str(), "\n");
+  }
+
+  {
+    std::ostringstream stream;
+    print(stream, LIB_FORMAT("Ala %0 kota"), "ma");
+    BOOST_CHECK_EQUAL(stream.str(), "Ala ma kota\n");
+  }
+
+  {
+    std::ostringstream stream;
+    Noncopyable non;
+    print(stream, LIB_FORMAT("%0 %1 %0 %2"), "Ala", "kota", non);
+    BOOST_CHECK_EQUAL(stream.str(), "Ala kota Ala noncopyable\n");
+  }
+
+  {
+    std::ostringstream stream;
+    print(stream, LIB_FORMAT("%%0 %0 %%%0%%"), "Ala");
+    BOOST_CHECK_EQUAL(stream.str(), "%0 Ala %Ala%\n");
+  }
+
+  {
+    std::ostringstream stream;
+    print(stream, LIB_FORMAT("%0%1 %2%3"), std::boolalpha, true, fancy, std::make_pair(1, 2));
+    BOOST_CHECK_EQUAL(stream.str(), "true (1, 2)\n");
+  }
+
+  {
+    std::ostringstream stream;
+    print(stream, LIB_FORMAT("%1%0"), 1, 2, 3);
+    BOOST_CHECK_EQUAL(stream.str(), "21\n");
+  }
+}
+
 BOOST_AUTO_TEST_CASE(pair_tuple_input_test) {
   {
     std::istringstream stream("1 2");
@@ -362,4 +401,315 @@ BOOST_AUTO_TEST_CASE(sequence_reader_test) {
   }
 }
 
+/**
+ * Temporary file with given content, rewound to the beginning.
+ */
+struct TemporaryFile {
+  TemporaryFile(const std::string& content):
+      file(std::tmpfile()) {
+    std::fputs(content.c_str(), file);
+    std::rewind(file);
+  }
+
+  ~TemporaryFile() {
+    std::fclose(file);
+  }
+
+  int descriptor() const {
+    return fileno(file);
+  }
+
+  std::string content() const {
+    std::rewind(file);
+    std::string result;
+    char buffer[4096];
+    size_t count;
+    while ((count = std::fread(buffer, 1, sizeof(buffer), file)) > 0)
+      result.append(buffer, count);
+    return result;
+  }
+
+  FILE* file;
+};
+
+BOOST_AUTO_TEST_CASE(fast_reader_test) {
+  {
+    TemporaryFile file("1 -2\n  3\t\n4294967295 -9223372036854775808");
+    FastReader reader(file.descriptor());
+    int a, b;
+    uint32 c, d;
+    int64 e;
+    reader >> a >> b >> c >> d >> e;
+    BOOST_CHECK(reader);
+    BOOST_CHECK_EQUAL(a, 1);
+    BOOST_CHECK_EQUAL(b, -2);
+    BOOST_CHECK_EQUAL(c, 3);
+    BOOST_CHECK_EQUAL(d, 4294967295u);
+    BOOST_CHECK_EQUAL(e, std::numeric_limits<int64>::min());
+    BOOST_CHECK(reader.eof());
+  }
+
+  {
+    TemporaryFile file("Ala ma\n\nkota x");
+    FastReader reader(file.descriptor());
+    std::string a, b, c;
+    char d;
+    reader >> a >> b >> c >> d;
+    BOOST_CHECK(reader);
+    BOOST_CHECK_EQUAL(a, "Ala");
+    BOOST_CHECK_EQUAL(b, "ma");
+    BOOST_CHECK_EQUAL(c, "kota");
+    BOOST_CHECK_EQUAL(d, 'x');
+  }
+
+  {
+    TemporaryFile file("12 abc");
+    FastReader reader(file.descriptor());
+    int a = 0, b = 0;
+    reader >> a >> b;
+    BOOST_CHECK(!reader);
+    BOOST_CHECK_EQUAL(a, 12);
+    BOOST_CHECK_EQUAL(b, 0);
+  }
+
+  {
+    TemporaryFile file("");
+    FastReader reader(file.descriptor());
+    int a = 0;
+    reader >> a;
+    BOOST_CHECK(!reader);
+    BOOST_CHECK(reader.eof());
+  }
+}
+
+BOOST_AUTO_TEST_CASE(fast_reader_buffer_boundary_test) {
+  std::string content;
+  std::string token(FastReader::kBufferSize / 2 + 3, 'a');
+  std::vector<uint64> numbers;
+  for (auto i: range<uint64>(0, 100 * 1000)) {
+    numbers.push_back(i * i * 1000003);
+    content += std::to_string(numbers.back());
+    content += (i % 2 == 0)? ' ' : '\n';
+  }
+  content += token;
+  content += ' ';
+  content += token;
+
+  TemporaryFile file(content);
+  FastReader reader(file.descriptor());
+  std::vector<uint64> result;
+  std::string first, second;
+  reader >> ReadSequence(uint32(numbers.size()), result) >> first >> second;
+  BOOST_CHECK(reader);
+  BOOST_CHECK(result == numbers);
+  BOOST_CHECK_EQUAL(first, token);
+  BOOST_CHECK_EQUAL(second, token);
+}
+
+BOOST_AUTO_TEST_CASE(fast_reader_read_test) {
+  {
+    TemporaryFile file("1 2 3");
+    FastReader reader(file.descriptor());
+    int a, b;
+    read(reader, a, ignore<int>(), b);
+    BOOST_CHECK_EQUAL(a, 1);
+    BOOST_CHECK_EQUAL(b, 3);
+  }
+
+  {
+    TemporaryFile file("Ala 1 2 3 4");
+    FastReader reader(file.descriptor());
+    std::tuple<std::string, int, int> tuple;
+    std::pair<int, int> pair;
+    read(reader, tuple, pair);
+    BOOST_CHECK(tuple == std::make_tuple(std::string("Ala"), 1, 2));
+    BOOST_CHECK(pair == std::make_pair(3, 4));
+  }
+
+  {
+    TemporaryFile file("1 2 3");
+    FastReader reader(file.descriptor());
+    int a, b, c;
+    reader >> std::tie(a, b, c);
+    BOOST_CHECK_EQUAL(a, 1);
+    BOOST_CHECK_EQUAL(b, 2);
+    BOOST_CHECK_EQUAL(c, 3);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(mapped_file_iterate_lines_test) {
+  auto lines = [](const std::string& content) {
+    TemporaryFile file(content);
+    MappedFile mapped(file.descriptor());
+    BOOST_CHECK_EQUAL(mapped.size(), content.size());
+    std::vector<std::string> result;
+    for (string_ref line: iterate_lines(mapped))
+      result.push_back(line.str());
+    return result;
+  };
+
+  {
+    std::vector<std::string> expected_result = {""};
+    BOOST_CHECK(lines("") == expected_result);
+  }
+
+  {
+    std::vector<std::string> expected_result = {"Ala"};
+    BOOST_CHECK(lines("Ala") == expected_result);
+  }
+
+  {
+    std::vector<std::string> expected_result = {"Ala", ""};
+    BOOST_CHECK(lines("Ala\n") == expected_result);
+  }
+
+  {
+    std::vector<std::string> expected_result = {"Ala", "ma", "", "kota"};
+    BOOST_CHECK(lines("Ala\nma\n\nkota") == expected_result);
+  }
+
+  {
+    std::string content = "Ala\nma\n\nkota\n";
+    TemporaryFile file(content);
+    MappedFile mapped(file.descriptor());
+    MappedFile moved(std::move(mapped));
+    BOOST_CHECK_EQUAL(mapped.size(), 0);
+    std::istringstream stream(content);
+    std::vector<std::string> expected_result;
+    for (const auto& line: iterate_lines(stream))
+      expected_result.push_back(line);
+    std::vector<std::string> result;
+    for (const auto& line: iterate_lines(moved))
+      result.push_back(line.str());
+    BOOST_CHECK(result == expected_result);
+  }
+
+  BOOST_CHECK_THROW(MappedFile("/nonexistent/file"), std::exception);
+}
+
+BOOST_AUTO_TEST_CASE(string_ref_test) {
+  std::string text = "Ala ma kota";
+  string_ref ref(text.data() + 4, 2);
+  BOOST_CHECK_EQUAL(ref.size(), 2);
+  BOOST_CHECK(ref == string_ref("ma"));
+  BOOST_CHECK(ref != string_ref("ko"));
+  BOOST_CHECK(string_ref() == string_ref(""));
+  BOOST_CHECK_EQUAL(string_ref("Ala").size(), 3);
+  BOOST_CHECK(!(std::is_constructible<string_ref, std::string&&>::value));
+  BOOST_CHECK_EQUAL(ref.str(), "ma");
+
+  std::ostringstream stream;
+  stream << ref;
+  BOOST_CHECK_EQUAL(stream.str(), "ma");
+}
+
+BOOST_AUTO_TEST_CASE(fast_writer_test) {
+  {
+    TemporaryFile file("");
+    {
+      FastWriter writer(file.descriptor());
+      writer << 0 << ' ' << -1 << ' ' << 10 << ' ' << 99 << ' ' << 100 << ' ' << 12345;
+      writer << ' ' << std::numeric_limits<int64>::min();
+      writer << ' ' << std::numeric_limits<uint64>::max();
+      writer << ' ' << int16(-128) << ' ' << true;
+    }
+    BOOST_CHECK_EQUAL(file.content(), "0 -1 10 99 100 12345 -9223372036854775808 18446744073709551615 -128 1");
+  }
+
+  {
+    TemporaryFile file("");
+    FastWriter writer(file.descriptor());
+    writer << "Ala" << ' ' << std::string("ma") << newline << 'k';
+    BOOST_CHECK_EQUAL(file.content(), "");
+    writer.flush();
+    BOOST_CHECK_EQUAL(file.content(), "Ala ma\nk");
+    writer << std::endl;
+    BOOST_CHECK_EQUAL(file.content(), "Ala ma\nk\n");
+  }
+
+  {
+    TemporaryFile file("");
+    std::string expected;
+    {
+      FastWriter writer(file.descriptor());
+      for (auto i: range<uint32>(0, 100 * 1000)) {
+        writer << i * 7919u << newline;
+        expected += std::to_string(i * 7919u);
+        expected += '\n';
+      }
+      std::string long_text(3 * FastWriter::kBufferSize, 'x');
+      writer << long_text;
+      expected += long_text;
+    }
+    BOOST_CHECK(file.content() == expected);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(fast_writer_printing_test) {
+  {
+    TemporaryFile file("");
+    {
+      FastWriter writer(file.descriptor());
+      std::vector<int> v = {1, 2, 3};
+      writer << v << ' ' << std::make_pair(1, "Ala") << ' ' << std::make_tuple(1, 'c', std::string("ma"));
+    }
+    BOOST_CHECK_EQUAL(file.content(), "1 2 3 1 Ala 1 c ma");
+  }
+
+  {
+    TemporaryFile file("");
+    {
+      FastWriter writer(file.descriptor());
+      std::vector<std::pair<int, int>> v = {{1, 2}, {3, 4}};
+      writer << fancy << v << simple << ' ' << v;
+    }
+    BOOST_CHECK_EQUAL(file.content(), "((1, 2), (3, 4)) 1 2 3 4");
+  }
+
+  {
+    TemporaryFile file("");
+    {
+      FastWriter writer(file.descriptor());
+      print(writer, "%0 %1 %%%0%2", "Ala", 12, fancy);
+      print(writer, "%0%1", std::make_pair(1, 2), flush);
+      print(writer, LIB_FORMAT("%1 %0"), 1, std::make_tuple(2, 3));
+    }
+    BOOST_CHECK_EQUAL(file.content(), "Ala 12 %Ala\n(1, 2)\n(2, 3) 1\n");
+  }
+
+  {
+    TemporaryFile file("");
+    {
+      FastWriter writer(file.descriptor());
+      std::vector<double> v = {3.75, -0.5, 1e20};
+      writer << v << ' ' << 2.5f << ' ' << 1.0L / 3;
+      print(writer, " %0", 2.5);
+    }
+    std::ostringstream expected;
+    expected << 3.75 << ' ' << -0.5 << ' ' << 1e20 << ' ' << 2.5f << ' ' << 1.0L / 3 << ' ' << 2.5 << '\n';
+    BOOST_CHECK_EQUAL(file.content(), expected.str());
+  }
+
+  {
+    TemporaryFile file("");
+    FastWriter writer(file.descriptor());
+    BOOST_CHECK_THROW(print(writer, "%0 %2", "Ala"), std::exception);
+  }
+}
+
+#ifdef USE_INT128_TYPES
+
+BOOST_AUTO_TEST_CASE(fast_writer_int128_test) {
+  uint128 million = 1000 * 1000;
+  int128 n = million * million * million * million * million * million + million;
+  TemporaryFile file("");
+  {
+    FastWriter writer(file.descriptor());
+    writer << int128(0) << ' ' << n << ' ' << -n;
+  }
+  BOOST_CHECK_EQUAL(file.content(), "0 1000000000000000000000000000001000000 -1000000000000000000000000000001000000");
+}
+
+#endif
+
 BOOST_AUTO_TEST_SUITE_END()
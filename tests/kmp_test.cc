@@ -62,4 +62,72 @@ BOOST_AUTO_TEST_CASE(knuth_morris_pratt_test) {
   }
 }
 
+std::vector<uint64> NaiveMatches(const std::string& text, const std::string& pattern) {
+  std::vector<uint64> result;
+  for (size_t i = 0; i + pattern.size() <= text.size(); i++)
+    if (text.compare(i, pattern.size(), pattern) == 0)
+      result.push_back(i);
+  return result;
+}
+
+/**
+ * Feeds text to matcher in random chunks.
+ */
+template <typename Matcher>
+std::vector<uint64> ChunkedMatches(Matcher& matcher, const std::string& text) {
+  std::vector<uint64> result;
+  size_t begin = 0;
+  while (begin < text.size()) {
+    const size_t end = std::min(text.size(), begin + Random32() % 20);
+    matcher.feed(text.begin() + begin, text.begin() + end, result);
+    begin = end;
+  }
+  BOOST_CHECK_EQUAL(matcher.position(), text.size());
+  return result;
+}
+
+BOOST_AUTO_TEST_CASE(matcher_test) {
+  {
+    std::string text = "abababcab", pattern = "abab";
+    KnuthMorrisPrattMatcher<char> matcher(pattern.begin(), pattern.end());
+    std::vector<uint64> matches, expected = {0, 2};
+    matcher.feed(text.begin(), text.begin() + 3, matches);
+    matcher.feed(text.begin() + 3, text.end(), matches);
+    BOOST_CHECK(matches == expected);
+
+    uint32 count = 0;
+    matcher.reset();
+    matcher.feed(text.begin(), text.end(), [&count](uint64) { count++; });
+    BOOST_CHECK_EQUAL(count, 2);
+  }
+
+  {
+    std::string text = "xabcabcyabc", pattern = "abc";
+    KnuthMorrisPrattAutomaton automaton(pattern.begin(), pattern.end(), 'a', 3);
+    std::vector<uint64> matches, expected = {1, 4, 8};
+    automaton.feed(text.begin(), text.end(), matches);
+    BOOST_CHECK(matches == expected);
+  }
+
+  std::string empty;
+  BOOST_CHECK_THROW(KnuthMorrisPrattMatcher<char>(empty.begin(), empty.end()), std::invalid_argument);
+  BOOST_CHECK_THROW(KnuthMorrisPrattAutomaton(empty.begin(), empty.end(), 'a', 2), std::invalid_argument);
+  std::string outside = "abc";
+  BOOST_CHECK_THROW(KnuthMorrisPrattAutomaton(outside.begin(), outside.end(), 'a', 2), std::invalid_argument);
+
+  for (int test = 0; test < 200; test++) {
+    std::string text, pattern;
+    for (uint32 i = Random32() % 300; i > 0; i--)
+      text += char('a' + Random32() % 3);
+    for (uint32 i = 1 + Random32() % 6; i > 0; i--)
+      pattern += char('a' + Random32() % 2);
+
+    const std::vector<uint64> expected = NaiveMatches(text, pattern);
+    KnuthMorrisPrattMatcher<char> matcher(pattern.begin(), pattern.end());
+    BOOST_CHECK(ChunkedMatches(matcher, text) == expected);
+    KnuthMorrisPrattAutomaton automaton(pattern.begin(), pattern.end(), 'a', 2);
+    BOOST_CHECK(ChunkedMatches(automaton, text) == expected);
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
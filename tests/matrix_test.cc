@@ -0,0 +1,137 @@
+// Jakub Staroń, 2016
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+#include "numeric/matrix.h"
+
+
+using namespace lib;
+using namespace lib::numeric;
+
+BOOST_AUTO_TEST_SUITE(matrix_test)
+
+constexpr uint32 kPrime = 1000 * 1000 * 1000 + 7;
+using field = prime_field<kPrime>;
+
+template <typename T>
+Matrix<T> NaiveMultiply(const Matrix<T>& lhs, const Matrix<T>& rhs) {
+  Matrix<T> result(lhs.rows(), rhs.columns());
+  for (size_t i = 0; i < lhs.rows(); i++)
+    for (size_t j = 0; j < rhs.columns(); j++)
+      for (size_t k = 0; k < lhs.columns(); k++)
+        result(i, j) += lhs(i, k) * rhs(k, j);
+  return result;
+}
+
+template <typename T>
+Matrix<T> RandomMatrix(size_t rows, size_t columns) {
+  Matrix<T> result(rows, columns);
+  for (size_t i = 0; i < rows; i++)
+    for (size_t j = 0; j < columns; j++)
+      result(i, j) = Random32();
+  return result;
+}
+
+BOOST_AUTO_TEST_CASE(basic_test) {
+  Matrix<int64> a = {{1, 2, 3}, {4, 5, 6}};
+  Matrix<int64> b = {{1, 0}, {0, 1}, {1, 1}};
+  BOOST_CHECK_EQUAL(a.rows(), 2);
+  BOOST_CHECK_EQUAL(a.columns(), 3);
+  BOOST_CHECK(a * b == (Matrix<int64>{{4, 5}, {10, 11}}));
+  BOOST_CHECK(a.transposed() == (Matrix<int64>{{1, 4}, {2, 5}, {3, 6}}));
+  BOOST_CHECK(a + a - a == a);
+  BOOST_CHECK(a * std::vector<int64>({1, 1, 1}) == std::vector<int64>({6, 15}));
+  BOOST_CHECK(Matrix<int64>::Identity(2) * a == a);
+  BOOST_CHECK_THROW(a * a, std::invalid_argument);
+  BOOST_CHECK_THROW(a + b, std::invalid_argument);
+  BOOST_CHECK_THROW(power(a, 2), std::invalid_argument);
+  BOOST_CHECK_THROW((Matrix<int64>{{1, 2}, {3}}), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(field_multiplication_test) {
+  for (size_t size: {1, 7, 64, 100, 130}) {
+    auto a = RandomMatrix<field>(size, size + 3);
+    auto b = RandomMatrix<field>(size + 3, size + 1);
+    BOOST_CHECK(a * b == NaiveMultiply(a, b));
+  }
+
+  using big_field = prime_field<uint32_prime1>;
+  auto a = RandomMatrix<big_field>(70, 70);
+  auto b = RandomMatrix<big_field>(70, 70);
+  BOOST_CHECK(a * b == NaiveMultiply(a, b));
+
+  using montgomery = montgomery_field<kPrime>;
+  auto c = RandomMatrix<montgomery>(70, 90);
+  auto d = RandomMatrix<montgomery>(90, 50);
+  BOOST_CHECK(c * d == NaiveMultiply(c, d));
+
+  using dynamic = dynamic_field<>;
+  dynamic::setPrime(998244353);
+  auto e = RandomMatrix<dynamic>(65, 65);
+  BOOST_CHECK(e * e == NaiveMultiply(e, e));
+}
+
+BOOST_AUTO_TEST_CASE(power_test) {
+  Matrix<field> fibonacci = {{1, 1}, {1, 0}};
+  BOOST_CHECK_EQUAL(power(fibonacci, 0)(0, 1), 0);
+  BOOST_CHECK_EQUAL(power(fibonacci, 10)(0, 1), 55);
+  BOOST_CHECK_EQUAL(power(fibonacci, 90)(0, 1), field(2880067194370816120uLL));
+
+  auto a = RandomMatrix<field>(20, 20);
+  auto expected = Matrix<field>::Identity(20);
+  for (int i = 0; i < 13; i++)
+    expected = NaiveMultiply(expected, a);
+  BOOST_CHECK(power(a, 13) == expected);
+}
+
+BOOST_AUTO_TEST_CASE(berlekamp_massey_test) {
+  BOOST_CHECK(BerlekampMassey<field>({0, 1, 1, 2, 3, 5, 8}) == (std::vector<field>{1, 1}));
+  BOOST_CHECK(BerlekampMassey<field>({1, 2, 4, 8, 16}) == (std::vector<field>{2}));
+  BOOST_CHECK(BerlekampMassey<field>({0, 0, 0}).empty());
+  BOOST_CHECK(BerlekampMassey<field>({0, 0, 5, 0}) == (std::vector<field>{0, 0, 5}));
+
+  // random recurrence of order 30 is recovered from 60 terms
+  const size_t k = 30;
+  std::vector<field> coefficients, sequence;
+  for (size_t i = 0; i < k; i++) {
+    coefficients.push_back(Random32());
+    sequence.push_back(Random32());
+  }
+  for (size_t n = k; n < 2 * k; n++) {
+    field term = 0;
+    for (size_t i = 0; i < k; i++)
+      term += coefficients[i] * sequence[n - 1 - i];
+    sequence.push_back(term);
+  }
+  BOOST_CHECK(BerlekampMassey(sequence) == coefficients);
+}
+
+BOOST_AUTO_TEST_CASE(linear_recurrence_test) {
+  BOOST_CHECK_EQUAL(LinearRecurrenceTerm<field>({1, 1}, {0, 1}, 0), 0);
+  BOOST_CHECK_EQUAL(LinearRecurrenceTerm<field>({1, 1}, {0, 1}, 10), 55);
+  BOOST_CHECK_EQUAL(LinearRecurrenceTerm<field>({1, 1}, {0, 1}, 90), field(2880067194370816120uLL));
+  BOOST_CHECK_EQUAL(LinearRecurrenceTerm<field>({2}, {3}, 10), 3 * 1024);
+  BOOST_CHECK_EQUAL(LinearRecurrenceTerm<field>({}, {}, 10), 0);
+  BOOST_CHECK_THROW(LinearRecurrenceTerm<field>({1, 1}, {0}, 10), std::invalid_argument);
+
+  // compare with matrix power
+  const size_t k = 17;
+  std::vector<field> coefficients, initial;
+  for (size_t i = 0; i < k; i++) {
+    coefficients.push_back(Random32());
+    initial.push_back(Random32());
+  }
+  Matrix<field> companion(k, k);
+  for (size_t i = 0; i < k; i++)
+    companion(0, i) = coefficients[i];
+  for (size_t i = 1; i < k; i++)
+    companion(i, i - 1) = 1;
+  std::vector<field> reversed(initial.rbegin(), initial.rend());
+  for (uint64 n: {17uLL, 18uLL, 100uLL, 12345678901234uLL}) {
+    const field expected = (power(companion, n - k + 1) * reversed)[0];
+    BOOST_CHECK_EQUAL(LinearRecurrenceTerm(coefficients, initial, n), expected);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,150 @@
+// Jakub Staroń, 2016
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+#include "numeric.h"
+#include "numeric/prime_field.h"
+#include "numeric/montgomery_field.h"
+#include "io.h"
+
+using namespace lib;
+
+BOOST_AUTO_TEST_SUITE(montgomery_field_suite)
+
+/**
+ * Checks arithmetic of field given by template with prime parameter,
+ * the same cases as prime_field_test.
+ */
+template <template <uint32> class Field>
+void CheckField() {
+  using small = Field<5>;
+  using big = Field<uint32_prime1>;
+
+  // creation
+  BOOST_CHECK_EQUAL(Field<7>(10).value(), 3);
+  BOOST_CHECK_EQUAL(small(10).value(), 0);
+  BOOST_CHECK_EQUAL(small(-1).value(), 4);
+  BOOST_CHECK_EQUAL(small((1uLL << 63) + uint64(1000 * 1000 * 1000)).value(), 3);
+  BOOST_CHECK_EQUAL(small(int64((1uLL << 62) + uint64(1000 * 1000 * 1000))).value(), 4);
+  BOOST_CHECK_EQUAL(small(-int64((1uLL << 62) + uint64(1000 * 1000 * 1000))).value(), 1);
+  BOOST_CHECK_EQUAL(big(uint64(uint32_prime1) * uint64(uint32_prime1) + 100).value(), 100);
+  BOOST_CHECK_EQUAL(big(uint32_prime1 - 1).value(), big(-1).value());
+  BOOST_CHECK_EQUAL(big(-int64(uint32_prime1) - int64(uint32_prime1) - 10), -10);
+  BOOST_CHECK_EQUAL(big((int64(uint32_prime1) << 20) + 10).value(), 10);
+
+  // addition and subtraction
+  {
+    small a(2), b(3);
+    BOOST_CHECK_EQUAL(a + a, 4);
+    BOOST_CHECK_EQUAL(a + b, 0);
+    BOOST_CHECK_EQUAL(a + a + b, a);
+    BOOST_CHECK_EQUAL(a - b, 4);
+    BOOST_CHECK_EQUAL(b - a - a, 4);
+  }
+  {
+    big a(uint32_prime1 - 1), b(uint32_prime1 - 2);
+    BOOST_CHECK_EQUAL(a + b + 3, 0);
+    BOOST_CHECK_EQUAL(3 + a + b, 0);
+    BOOST_CHECK_EQUAL(a + a + b + 8, 4);
+    BOOST_CHECK_EQUAL(a - b, 1);
+    BOOST_CHECK_EQUAL(b - a, uint32_prime1 - 1);
+    BOOST_CHECK_EQUAL(b - (uint32_prime1 + 1) + 3, 0);
+  }
+
+  // multiplication, division and inverse
+  {
+    small a(1), b(2);
+    BOOST_CHECK_EQUAL(a * 1, a);
+    BOOST_CHECK_EQUAL(a * 0, 0);
+    BOOST_CHECK_EQUAL(b * b * b, 3);
+    BOOST_CHECK_EQUAL(2 / b, 1);
+    BOOST_CHECK_EQUAL(9 / b, 2);
+    BOOST_CHECK_EQUAL(b / 3, 4);
+    BOOST_CHECK_EQUAL(inverse(b), 3);
+  }
+  {
+    big a(uint32_prime1 - 1), b(uint32_prime1 - 2);
+    BOOST_CHECK_EQUAL(a * b, 2);
+    BOOST_CHECK_EQUAL(b * b * b * b, 16);
+    BOOST_CHECK_EQUAL(b / a, 2);
+    BOOST_CHECK_EQUAL(inverse(a / b), 2);
+    BOOST_CHECK_EQUAL(inverse(big(5)), 3435973833u);
+    BOOST_CHECK_EQUAL(inverse(big(1336367439u)), 123456);
+    BOOST_CHECK_EQUAL(big(123456) * 1336367439u, 1);
+  }
+  BOOST_CHECK_EQUAL(inverse(Field<7>(3)), 5);
+  BOOST_CHECK_EQUAL(inverse(Field<13>(5)), 8);
+
+  // shortcut operators
+  {
+    small a(2), b(3);
+    a += b;
+    BOOST_CHECK_EQUAL(a, 0);
+    a -= b;
+    BOOST_CHECK_EQUAL(a, 2);
+    a *= b;
+    BOOST_CHECK_EQUAL(a, 1);
+    a /= b;
+    BOOST_CHECK_EQUAL(a, 2);
+    a += a;
+    BOOST_CHECK_EQUAL(a, 4);
+    BOOST_CHECK_EQUAL(b, 3);
+  }
+
+  // io and equality
+  {
+    std::ostringstream stream;
+    stream << small(9) << ' ' << big(uint32_prime1 - 1);
+    BOOST_CHECK_EQUAL(stream.str(), "4 " + std::to_string(uint32_prime1 - 1));
+  }
+  {
+    std::istringstream stream("1234 -1 " + std::to_string(uint32_prime1 - 1));
+    small a, b;
+    big c;
+    stream >> a >> b >> c;
+    BOOST_CHECK_EQUAL(a, 4);
+    BOOST_CHECK_EQUAL(b, 4);
+    BOOST_CHECK_EQUAL(c, uint32_prime1 - 1);
+  }
+  BOOST_CHECK(small(2) == small(7));
+  BOOST_CHECK(small(2) != small(3));
+}
+
+BOOST_AUTO_TEST_CASE(arithmetic_test) {
+  CheckField<numeric::montgomery_field>();
+}
+
+BOOST_AUTO_TEST_CASE(compatibility_with_prime_field_test) {
+  constexpr uint32 kPrime = 1000 * 1000 * 1000 + 7;
+  using montgomery = numeric::montgomery_field<kPrime>;
+  using field = numeric::prime_field<kPrime>;
+  using big_montgomery = numeric::montgomery_field<uint32_prime1>;
+  using big_field = numeric::prime_field<uint32_prime1>;
+
+  auto check = [](uint32 a, uint32 b) {
+    BOOST_CHECK_EQUAL((montgomery(a) + montgomery(b)).value(), (field(a) + field(b)).value());
+    BOOST_CHECK_EQUAL((montgomery(a) - montgomery(b)).value(), (field(a) - field(b)).value());
+    BOOST_CHECK_EQUAL((montgomery(a) * montgomery(b)).value(), (field(a) * field(b)).value());
+    BOOST_CHECK_EQUAL(power(montgomery(a), b).value(), power(field(a), b).value());
+    BOOST_CHECK_EQUAL((big_montgomery(a) + big_montgomery(b)).value(), (big_field(a) + big_field(b)).value());
+    BOOST_CHECK_EQUAL((big_montgomery(a) - big_montgomery(b)).value(), (big_field(a) - big_field(b)).value());
+    BOOST_CHECK_EQUAL((big_montgomery(a) * big_montgomery(b)).value(), (big_field(a) * big_field(b)).value());
+  };
+
+  check(0, 0);
+  check(kPrime - 1, kPrime - 1);
+  check(kPrime - 1, 1);
+  for (auto i: range<uint32>(0, 1000))
+    check(Random32(), Random32());
+}
+
+BOOST_AUTO_TEST_CASE(constexpr_test) {
+  constexpr numeric::montgomery_field<13> a(5);
+  constexpr numeric::montgomery_field<13> b(9);
+  static_assert((a * b).value() == 6, "montgomery_field multiplication should be constexpr");
+  static_assert((a + b).value() == 1, "montgomery_field addition should be constexpr");
+  static_assert((a - b).value() == 9, "montgomery_field subtraction should be constexpr");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
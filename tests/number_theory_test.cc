@@ -129,6 +129,37 @@ BOOST_AUTO_TEST_CASE(operations_32bits_test) {
   BOOST_CHECK_EQUAL(Multiply32((1u << 31) - 1, (1u << 31) - 2, (1u << 31)), 2);
 }
 
+BOOST_AUTO_TEST_CASE(operations_64bits_test) {
+  using namespace lib;
+
+  BOOST_CHECK_EQUAL(Multiply64(4, 5, 6), 2);
+  BOOST_CHECK_EQUAL(Multiply64(0, 0, 13), 0);
+  BOOST_CHECK_EQUAL(Multiply64(uint64(-1), uint64(-1), uint64(-2)), 1);
+  BOOST_CHECK_EQUAL(Multiply64(1uLL << 62, 1uLL << 62, (1uLL << 62) + 1), 1);
+
+  auto MultiplyByDoubling = [](uint64 a, uint64 b, uint64 modulo) {
+    auto add = [modulo](uint64 x, uint64 y) { return (x >= modulo - y)? x - (modulo - y) : x + y; };
+    uint64 result = 0;
+    for (a %= modulo; b > 0; b /= 2) {
+      if (b % 2 == 1)
+        result = add(result, a);
+      a = add(a, a);
+    }
+    return result;
+  };
+
+  for (auto i: range<uint32>(0, 10000)) {
+    const uint64 modulo = std::max<uint64>(1, Random64() >> (i % 64));
+    const uint64 a = Random64(), b = Random64();
+    BOOST_CHECK_EQUAL(Multiply64(a, b, modulo), MultiplyByDoubling(a, b, modulo));
+  }
+
+  BOOST_CHECK_EQUAL(PowerModulo64(2, 64, uint64_prime1), uint64(-1) % uint64_prime1 + 1);
+  BOOST_CHECK_EQUAL(PowerModulo64(3, 0, 1000), 1);
+  BOOST_CHECK_EQUAL(PowerModulo64(3, 7, 1000), 187);
+  BOOST_CHECK_EQUAL(PowerModulo64(999999999999999988uLL, 999999999999999988uLL, 999999999999999989uLL), 1);
+}
+
 BOOST_AUTO_TEST_CASE(power_modulo_test) {
   lib::uint64 modulo = lib::power(10, 9) + 7;
   BOOST_CHECK_EQUAL(PowerModulo32(2, lib::power(10, 17), modulo), 952065854);
@@ -248,6 +279,129 @@ BOOST_AUTO_TEST_CASE(factorization_test) {
   }
 }
 
+BOOST_AUTO_TEST_CASE(factorization64_test) {
+  using namespace lib;
+
+  auto Defactorize = [](const std::vector<uint64>& v) {
+    uint64 result = 1;
+    for (auto i: v)
+      result *= i;
+    return result;
+  };
+
+  BOOST_CHECK(Factorize64(0).empty());
+  BOOST_CHECK(Factorize64(1).empty());
+
+  std::vector<uint64> numbers = {
+      2, 47, 64, 12345678, 1000000007uLL * 998244353uLL, 999999999999999989uLL,
+      4294967279uLL * 4294967291uLL, 18446744073709551557uLL, 18446744073709551615uLL,
+      1uLL << 63, 9746347772161uLL, 1000003uLL * 1000003uLL * 17, 3uLL * 3 * 3 * 3 * 3 * 3 * 3 * 3 * 3 * 3 * 3 * 3 * 3
+  };
+  for (auto i: range<uint32>(0, 1000))
+    numbers.push_back(Random64());
+
+  for (auto n: numbers) {
+    auto factorization = Factorize64(n);
+    BOOST_CHECK(std::is_sorted(factorization.begin(), factorization.end()));
+    BOOST_CHECK_EQUAL(Defactorize(factorization), n);
+    BOOST_CHECK_MESSAGE(std::all_of(factorization.begin(), factorization.end(), IsPrime),
+                        "Not prime factor in factorization of " << n);
+  }
+
+  for (auto n: range<uint32>(1, 10000)) {
+    auto expected = Factorize(n);
+    auto factorization = Factorize64(n);
+    BOOST_CHECK(std::equal(expected.begin(), expected.end(), factorization.begin()));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(montgomery64_test) {
+  using namespace lib;
+
+  for (uint64 modulo: std::vector<uint64>{3, 1000000007, 999999999999999989uLL, 18446744073709551557uLL, uint64(-1)}) {
+    Montgomery64 montgomery(modulo);
+    for (auto i: range<uint32>(0, 1000)) {
+      const uint64 a = Random64() % modulo;
+      const uint64 b = Random64() % modulo;
+      const uint64 x = montgomery.toMontgomery(a);
+      const uint64 y = montgomery.toMontgomery(b);
+      BOOST_CHECK_EQUAL(montgomery.fromMontgomery(x), a);
+      BOOST_CHECK_EQUAL(montgomery.fromMontgomery(montgomery.add(x, y)), (a >= modulo - b)? a - (modulo - b) : a + b);
+      BOOST_CHECK_EQUAL(montgomery.fromMontgomery(montgomery.subtract(x, y)), (a >= b)? a - b : a - b + modulo);
+
+      uint64 product = 0, power = b;
+      for (uint64 n = a; n > 0; n /= 2) { // multiplication by doubling, slow but certainly correct
+        if (n % 2 == 1)
+          product = (product >= modulo - power)? product - (modulo - power) : product + power;
+        power = (power >= modulo - power)? power - (modulo - power) : power + power;
+      }
+      BOOST_CHECK_EQUAL(montgomery.fromMontgomery(montgomery.multiply(x, y)), product);
+    }
+    BOOST_CHECK_EQUAL(montgomery.fromMontgomery(montgomery.power(montgomery.toMontgomery(2), 0)), 1);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(linear_sieve_test) {
+  using namespace lib;
+
+  constexpr uint32 N = 3000;
+  LinearSieve sieve(N);
+  BOOST_CHECK_EQUAL(sieve.size(), N);
+  BOOST_CHECK(sieve.primes() == PrimeNumbers(N));
+
+  const auto totients = sieve.totients();
+  const auto mobius = sieve.mobius();
+  const auto divisor_counts = sieve.divisorCounts();
+  const auto divisor_sums = sieve.multiplicative<uint64>([](uint32 p, uint32, uint32 power) {
+    return (uint64(power) * p - 1) / (p - 1);
+  });
+
+  BOOST_CHECK_EQUAL(totients[0], 0);
+  BOOST_CHECK_EQUAL(totients[1], 1);
+  BOOST_CHECK_EQUAL(mobius[1], 1);
+  BOOST_CHECK_EQUAL(divisor_counts[1], 1);
+
+  for (auto k: range<uint32>(2, N)) {
+    BOOST_CHECK_EQUAL(sieve.isPrime(k), IsPrime(k));
+    BOOST_CHECK_EQUAL(sieve.smallestPrimeFactor(k), Factorize(k).front());
+
+    std::vector<uint32> factorization;
+    uint32 n = k;
+    for (uint32 d = 2; d <= n; ++d)
+      for (; n % d == 0; n /= d)
+        factorization.push_back(d);
+    BOOST_CHECK(sieve.factorize(k) == factorization);
+
+    std::vector<uint32> divisors;
+    uint64 divisor_sum = 0;
+    for (uint32 d = 1; d <= k; ++d) {
+      if (k % d == 0) {
+        divisors.push_back(d);
+        divisor_sum += d;
+      }
+    }
+    BOOST_CHECK(sieve.divisors(k) == divisors);
+    BOOST_CHECK_EQUAL(divisor_counts[k], divisors.size());
+    BOOST_CHECK_EQUAL(divisor_sums[k], divisor_sum);
+
+    uint32 coprime = 0;
+    for (uint32 d = 1; d <= k; ++d)
+      coprime += (GCD(d, k) == 1);
+    BOOST_CHECK_EQUAL(totients[k], coprime);
+
+    const bool square_free = std::adjacent_find(factorization.begin(), factorization.end()) == factorization.end();
+    const int expected_mobius = square_free? ((factorization.size() % 2 == 0)? 1 : -1) : 0;
+    BOOST_CHECK_EQUAL(int(mobius[k]), expected_mobius);
+  }
+
+  BOOST_CHECK(LinearSieve(0).primes().empty());
+  BOOST_CHECK(LinearSieve(2).totients() == std::vector<uint32>({0, 1}));
+  BOOST_CHECK(sieve.divisors(1) == std::vector<uint32>({1}));
+  BOOST_CHECK(Divisors(0).empty());
+  BOOST_CHECK(Factorize(0).empty());
+  BOOST_CHECK(Factorize(1).empty());
+}
+
 BOOST_AUTO_TEST_CASE(primes_test) {
   using namespace lib;
 
@@ -281,6 +435,119 @@ BOOST_AUTO_TEST_CASE(primes_test) {
   BOOST_CHECK(!IsPrime(340561)); // 13 * 17 * 23 * 67
 }
 
+BOOST_AUTO_TEST_CASE(prime_numbers_test) {
+  using namespace lib;
+
+  auto primes = PrimeNumbers(100);
+  std::vector<uint32> expected = {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41,
+                                  43, 47, 53, 59, 61, 67, 71, 73, 79, 83, 89, 97};
+  BOOST_CHECK(primes == expected);
+  BOOST_CHECK(PrimeNumbers(0).empty());
+  BOOST_CHECK(PrimeNumbers(2).empty());
+  BOOST_CHECK_EQUAL(PrimeNumbers(3).size(), 1);
+  BOOST_CHECK_EQUAL(PrimeNumbers(10 * 1000 * 1000).size(), 664579);
+}
+
+BOOST_AUTO_TEST_CASE(segmented_sieve_test) {
+  using namespace lib;
+
+  std::vector<std::pair<uint64, uint64>> ranges = {
+      {0, 0}, {0, 1}, {0, 2}, {0, 3}, {2, 3}, {3, 12}, {10, 10}, {14, 13},
+      {1000, 3000}, {Billion, Billion + 200 * 1000}, {1uLL << 40, (1uLL << 40) + 20 * 1000},
+      {Billion * Thousand - 10 * 1000, Billion * Thousand + 10 * 1000}
+  };
+  for (auto r: ranges) {
+    std::vector<uint64> primes;
+    ForEachPrime(r.first, r.second, [&primes](uint64 p) { primes.push_back(p); });
+
+    std::vector<uint64> expected;
+    for (uint64 i = r.first; i < r.second; ++i)
+      if (IsPrime(i))
+        expected.push_back(i);
+
+    BOOST_CHECK_MESSAGE(primes == expected, "ForEachPrime differs from IsPrime for [" << r.first << ", " << r.second << ")");
+    BOOST_CHECK_EQUAL(CountPrimes(r.first, r.second), expected.size());
+  }
+
+  BOOST_CHECK_EQUAL(CountPrimes(0, 100 * Million), 5761455);
+  BOOST_CHECK_EQUAL(CountPrimes(Billion - 100 * Million, Billion), 50847534 - 46009215);
+}
+
+BOOST_AUTO_TEST_CASE(prime_counting_test) {
+  using namespace lib;
+
+  std::vector<uint64> pi = {0, 4, 25, 168, 1229, 9592, 78498, 664579, 5761455, 50847534, 455052511, 4118054813uLL};
+  for (auto k: range<size_t>(1, pi.size()))
+    BOOST_CHECK_EQUAL(PrimePi(power(10, k)), pi[k]);
+  BOOST_CHECK_EQUAL(PrimePi(0), 0);
+  BOOST_CHECK_EQUAL(PrimePi(1), 0);
+  BOOST_CHECK_EQUAL(PrimePi(2), 1);
+  BOOST_CHECK_THROW(PrimePi(std::numeric_limits<uint64>::max()), std::invalid_argument);
+
+  for (auto i: range<uint32>(0, 200)) {
+    const uint64 n = Random64() % (i < 180? 1000 : 10 * Million);
+    uint64 count = 0, sum = 0, squares = 0;
+    ForEachPrime(0, n + 1, [&](uint64 p) {
+      count++;
+      sum += p;
+      squares += p * p;
+    });
+    BOOST_CHECK_EQUAL(PrimePi(n), count);
+    BOOST_CHECK_EQUAL(PrimeSum(n), sum);
+
+    auto SumOfSquares = [](uint64 v) {
+      uint64 result = 0;
+      for (uint64 k = 2; k <= v; ++k)
+        result += k * k;
+      return result;
+    };
+    if (n < 1000)
+      BOOST_CHECK_EQUAL(SumOverPrimes<uint64>(n, [](uint64 p) { return p * p; }, SumOfSquares), squares);
+  }
+
+  BOOST_CHECK_EQUAL(PrimeSum(2 * Million), 142913828922uLL);
+}
+
+BOOST_AUTO_TEST_CASE(parallel_sieve_test) {
+  using namespace lib;
+
+  std::vector<std::pair<uint64, uint64>> ranges = {
+      {0, 0}, {0, 100}, {5, 3}, {0, 100 * Million}, {Billion + 12345, Billion + 54321 * 1000}
+  };
+  for (auto r: ranges) {
+    std::vector<uint64> expected;
+    ForEachPrime(r.first, r.second, [&expected](uint64 p) { expected.push_back(p); });
+
+    for (uint32 threads: {1, 2, 5}) {
+      BOOST_CHECK_EQUAL(CountPrimesParallel(r.first, r.second, threads), expected.size());
+
+      std::vector<uint64> primes;
+      ForEachPrimeParallel(r.first, r.second, threads, [&primes](uint64 p) { primes.push_back(p); });
+      BOOST_CHECK(primes == expected);
+
+      std::mutex mutex;
+      std::vector<uint64_pair> segments;
+      ForEachSegmentParallel(r.first, r.second, threads, [&](numeric::SegmentedSieve& sieve) {
+        std::lock_guard<std::mutex> lock(mutex);
+        segments.emplace_back(sieve.begin(), sieve.end());
+      });
+      std::sort(segments.begin(), segments.end());
+      uint64 covered = r.first;
+      for (auto segment: segments) {
+        BOOST_CHECK_EQUAL(segment.first, covered);
+        covered = segment.second;
+      }
+      BOOST_CHECK_EQUAL(covered, std::max(r.first, r.second));
+    }
+  }
+
+  uint64 count = 0;
+  BOOST_CHECK_THROW(ForEachPrimeParallel(0, 100 * Million, 3, [&count](uint64) {
+    if (++count == Million)
+      throw std::runtime_error("stop");
+  }), std::runtime_error);
+}
+
 BOOST_AUTO_TEST_CASE(is_primitive_root_test) {
   BOOST_CHECK_EQUAL(IsPrimitiveRoot(0, 2), false);
   BOOST_CHECK_EQUAL(IsPrimitiveRoot(1, 2), true);
@@ -325,6 +592,26 @@ BOOST_AUTO_TEST_CASE(discrete_logarithm_test) {
   BOOST_CHECK_EQUAL(DiscreteLogarithm(2, 4, 7), 2);
   BOOST_CHECK_EQUAL(DiscreteLogarithm(3, 5, 7), 5);
   BOOST_CHECK_EQUAL(DiscreteLogarithm(3, 1431655764, 0xFFFFFFFB), 2147483644);
+  BOOST_CHECK_THROW(DiscreteLogarithm(2, 3, 7), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(discrete_logarithm_batch_test) {
+  using namespace lib;
+
+  BOOST_CHECK(DiscreteLogarithm(3, std::vector<uint32>{1, 3, 2, 6, 4, 5}, 7) ==
+      (std::vector<uint32>{0, 1, 2, 3, 4, 5}));
+  BOOST_CHECK(DiscreteLogarithm(3, std::vector<uint32>{}, 7).empty());
+
+  const uint32 p = 2147483647;
+  DiscreteLogarithmSolver solver(7, p, 64);
+  for (uint32 k: {0u, 1u, 12345u, 1u << 30, p - 2}) {
+    BOOST_CHECK_EQUAL(solver.logarithm(PowerModulo32(7, k, p)), k);
+  }
+
+  DiscreteLogarithmSolver small_order(2, 7, 100);
+  BOOST_CHECK_EQUAL(small_order.order(), 3);
+  BOOST_CHECK_EQUAL(small_order.logarithm(4), 2);
+  BOOST_CHECK_THROW(small_order.logarithm(3), std::runtime_error);
 }
 
 BOOST_AUTO_TEST_SUITE_END()
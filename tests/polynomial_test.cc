@@ -0,0 +1,190 @@
+// Jakub Staroń, 2016
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+#include "numeric/polynomial.h"
+#include "io.h"
+
+using namespace lib;
+using namespace lib::numeric;
+
+namespace {
+
+constexpr uint32 kPrime = ntt_prime1;
+using field = prime_field<kPrime>;
+using polynomial_type = polynomial::polynomial_type<kPrime>;
+
+polynomial_type RandomPolynomial(size_t size, std::mt19937& engine) {
+  std::uniform_int_distribution<uint32> distribution(0, kPrime - 1);
+  polynomial_type result(size);
+  for (auto& coefficient: result)
+    coefficient = distribution(engine);
+  return result;
+}
+
+polynomial_type NaiveMultiply(const polynomial_type& a, const polynomial_type& b) {
+  polynomial_type result(a.size() + b.size() - 1);
+  for (auto i: range<size_t>(0, a.size()))
+    for (auto j: range<size_t>(0, b.size()))
+      result[i + j] += a[i] * b[j];
+  return result;
+}
+
+polynomial_type Truncated(polynomial_type a, size_t n) {
+  a.resize(n);
+  return a;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(polynomial_suite)
+
+BOOST_AUTO_TEST_CASE(transform_test) {
+  std::mt19937 engine(1);
+  for (size_t size: {1, 2, 4, 8, 1024, 1 << 14}) {
+    polynomial_type values = RandomPolynomial(size, engine);
+    polynomial_type transformed = values;
+    NumberTheoreticTransform(transformed);
+    InverseNumberTheoreticTransform(transformed);
+    BOOST_CHECK(transformed == values);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(transform_too_big_test) {
+  polynomial_type values(size_t(1) << 24);
+  BOOST_CHECK_THROW(NumberTheoreticTransform(values), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(multiply_test) {
+  {
+    polynomial_type a = {1, 2, 3};
+    polynomial_type b = {4, 5};
+    polynomial_type expected = {4, 13, 22, 15};
+    BOOST_CHECK(polynomial::Multiply(a, b) == expected);
+  }
+
+  BOOST_CHECK(polynomial::Multiply(polynomial_type(), polynomial_type{1}).empty());
+
+  std::mt19937 engine(2);
+  for (auto sizes: {std::make_pair(33, 33), std::make_pair(100, 1000), std::make_pair(1000, 1000),
+                    std::make_pair(1, 5000), std::make_pair(4097, 4097)}) {
+    polynomial_type a = RandomPolynomial(sizes.first, engine);
+    polynomial_type b = RandomPolynomial(sizes.second, engine);
+    BOOST_CHECK(polynomial::Multiply(a, b) == NaiveMultiply(a, b));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(inverse_test) {
+  std::mt19937 engine(3);
+  for (size_t n: {1, 2, 3, 100, 1000}) {
+    polynomial_type a = RandomPolynomial(n, engine);
+    a[0] = 7;
+    polynomial_type product = Truncated(polynomial::Multiply(a, polynomial::Inverse(a, n)), n);
+    polynomial_type expected(n);
+    expected[0] = 1;
+    BOOST_CHECK(product == expected);
+  }
+
+  {
+    // 1 / (1 - x) = 1 + x + x^2 + ...
+    polynomial_type expected(10, field(1));
+    BOOST_CHECK(polynomial::Inverse(polynomial_type{1, -1}, 10) == expected);
+  }
+
+  BOOST_CHECK_THROW(polynomial::Inverse(polynomial_type{0, 1}, 10), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(derivative_and_integral_test) {
+  polynomial_type a = {5, 3, 2, 7};
+  polynomial_type derivative = {3, 4, 21};
+  BOOST_CHECK(polynomial::Derivative(a) == derivative);
+  polynomial_type integral = polynomial::Integral(derivative);
+  a[0] = 0;
+  BOOST_CHECK(integral == a);
+}
+
+BOOST_AUTO_TEST_CASE(logarithm_and_exponent_test) {
+  {
+    // exp(x) = sum x^k / k!
+    polynomial_type expected(8);
+    field factorial = 1;
+    for (auto k: range<uint32>(0, 8)) {
+      if (k > 0)
+        factorial *= k;
+      expected[k] = inverse(factorial);
+    }
+    BOOST_CHECK(polynomial::Exponent(polynomial_type{0, 1}, 8) == expected);
+    BOOST_CHECK(Truncated(polynomial::Logarithm(polynomial::Exponent(polynomial_type{0, 1}, 8), 8), 2) ==
+                (polynomial_type{0, 1}));
+  }
+
+  std::mt19937 engine(4);
+  for (size_t n: {1, 2, 5, 64, 1000}) {
+    polynomial_type a = RandomPolynomial(n, engine);
+    a[0] = 0;
+    BOOST_CHECK(polynomial::Logarithm(polynomial::Exponent(a, n), n) == a);
+
+    a[0] = 1;
+    BOOST_CHECK(polynomial::Exponent(polynomial::Logarithm(a, n), n) == a);
+  }
+
+  BOOST_CHECK_THROW(polynomial::Logarithm(polynomial_type{2, 1}, 10), std::invalid_argument);
+  BOOST_CHECK_THROW(polynomial::Exponent(polynomial_type{1, 1}, 10), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(power_test) {
+  std::mt19937 engine(5);
+  for (size_t n: {1, 10, 300}) {
+    for (uint64 k: {0, 1, 2, 3, 7}) {
+      for (size_t shift: {0, 1, 4}) {
+        polynomial_type a = RandomPolynomial(n, engine);
+        for (auto i: range<size_t>(0, std::min(shift, n)))
+          a[i] = 0;
+
+        polynomial_type expected(n);
+        expected[0] = 1;
+        for (uint64 i = 0; i < k; ++i)
+          expected = Truncated(NaiveMultiply(expected, a), n);
+
+        BOOST_CHECK(polynomial::Power(a, k, n) == expected);
+      }
+    }
+  }
+
+  BOOST_CHECK(polynomial::Power(polynomial_type{0, 1}, 1uLL << 62, 10) == polynomial_type(10));
+  BOOST_CHECK(polynomial::Power(polynomial_type(), 2, 3) == polynomial_type(3));
+}
+
+BOOST_AUTO_TEST_CASE(multiply_modulo_test) {
+  std::mt19937 engine(6);
+  for (uint32 modulo: {2u, 1000000007u, 4294967291u}) {
+    std::uniform_int_distribution<uint32> distribution(0, modulo - 1);
+    for (auto sizes: {std::make_pair(1, 1), std::make_pair(50, 70), std::make_pair(1000, 700)}) {
+      std::vector<uint32> a(sizes.first), b(sizes.second);
+      for (auto& value: a) value = distribution(engine);
+      for (auto& value: b) value = distribution(engine);
+
+      std::vector<uint32> expected(a.size() + b.size() - 1);
+      for (auto i: range<size_t>(0, a.size()))
+        for (auto j: range<size_t>(0, b.size()))
+          expected[i + j] = (expected[i + j] + uint64(a[i]) * b[j]) % modulo;
+
+      BOOST_CHECK(polynomial::MultiplyModulo(a, b, modulo) == expected);
+    }
+  }
+
+  // coefficients are reduced first
+  const uint32 modulo = 1000 * 1000 * 1000 + 7;
+  std::vector<uint32> a(300), b(200);
+  for (auto& value: a) value = engine();
+  for (auto& value: b) value = engine() | (1u << 31);
+  std::vector<uint32> expected(a.size() + b.size() - 1);
+  for (auto i: range<size_t>(0, a.size()))
+    for (auto j: range<size_t>(0, b.size()))
+      expected[i + j] = (expected[i + j] + uint64(a[i] % modulo) * (b[j] % modulo)) % modulo;
+  BOOST_CHECK(polynomial::MultiplyModulo(a, b, modulo) == expected);
+  BOOST_CHECK_THROW(polynomial::MultiplyModulo(a, b, 0), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -194,6 +194,23 @@ BOOST_AUTO_TEST_CASE(inverse_test) {
   }
 }
 
+BOOST_AUTO_TEST_CASE(batch_inverse_test) {
+  using field = numeric::prime_field<uint32_prime1>;
+  std::vector<field> values;
+  for (uint32 i = 1; i <= 1000; i++)
+    values.push_back(field(i * 12345u));
+  std::vector<field> inversed = values;
+  numeric::batch_inverse(inversed.begin(), inversed.end());
+  for (size_t i = 0; i < values.size(); i++)
+    BOOST_CHECK_EQUAL(inversed[i], inverse(values[i]));
+
+  std::vector<field> empty;
+  numeric::batch_inverse(empty.begin(), empty.end());
+
+  std::vector<field> with_zero = {1, 0, 2};
+  BOOST_CHECK_THROW(numeric::batch_inverse(with_zero.begin(), with_zero.end()), std::runtime_error);
+}
+
 BOOST_AUTO_TEST_CASE(shortcut_operators_test) {
   {
     numeric::prime_field<5> a(2);
@@ -0,0 +1,52 @@
+// Jakub Staroń, 2016
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+#include "data_structures/rank_bit_vector.h"
+
+using namespace lib;
+
+BOOST_AUTO_TEST_SUITE(rank_bit_vector_test)
+
+BOOST_AUTO_TEST_CASE(simple_test) {
+  std::vector<bool> bits = {1, 0, 1, 1, 0};
+  RankBitVector vector(bits.begin(), bits.end());
+  BOOST_CHECK_EQUAL(vector.size(), 5);
+  BOOST_CHECK_EQUAL(vector.ones(), 3);
+  BOOST_CHECK_EQUAL(vector.rank(0), 0);
+  BOOST_CHECK_EQUAL(vector.rank(1), 1);
+  BOOST_CHECK_EQUAL(vector.rank(3), 2);
+  BOOST_CHECK_EQUAL(vector.rank(5), 3);
+  BOOST_CHECK(vector[0]);
+  BOOST_CHECK(!vector[1]);
+
+  RankBitVector empty;
+  BOOST_CHECK_EQUAL(empty.size(), 0);
+  BOOST_CHECK_EQUAL(empty.rank(0), 0);
+}
+
+BOOST_AUTO_TEST_CASE(random_test) {
+  // sizes around borders of words and blocks
+  for (uint32 size: {63, 64, 65, 447, 448, 449, 896, 5000}) {
+    for (uint32 density: {2, 10}) {
+      std::vector<uint8> bits(size);
+      for (auto& bit: bits)
+        bit = Random32() % density == 0;
+      RankBitVector vector(bits.begin(), bits.end());
+      RankBitVector copy(vector);
+      uint32 ones = 0;
+      for (uint32 i = 0; i <= size; i++) {
+        BOOST_CHECK_EQUAL(vector.rank(i), ones);
+        BOOST_CHECK_EQUAL(copy.rank(i), ones);
+        if (i < size) {
+          BOOST_CHECK_EQUAL(vector[i], bool(bits[i]));
+          ones += bits[i];
+        }
+      }
+      BOOST_CHECK_EQUAL(vector.ones(), ones);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,94 @@
+// Jakub Staroń, 2016
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+#include "text_algorithms/rolling_hasher.h"
+
+using namespace lib;
+
+BOOST_AUTO_TEST_SUITE(rolling_hasher_test)
+
+BOOST_AUTO_TEST_CASE(rolling_hasher_test) {
+  RollingHasher hasher(3);
+  BOOST_CHECK_EQUAL(hasher.window(), 3);
+  BOOST_CHECK(hasher.getHash() == hash::zero);
+
+  hasher.push('a');
+  hasher.push('b');
+  BOOST_CHECK(!hasher.full());
+  BOOST_CHECK_EQUAL(hasher.size(), 2);
+  BOOST_CHECK(hasher.getHash() == hash::hash("ab"));
+
+  hasher.push('c');
+  BOOST_CHECK(hasher.full());
+  BOOST_CHECK(hasher.getHash() == hash::hash("abc"));
+
+  std::string rest = "abab";
+  hasher.push(rest.begin(), rest.end());
+  BOOST_CHECK_EQUAL(hasher.size(), 3);
+  BOOST_CHECK(hasher.getHash() == hash::hash("bab"));
+
+  hasher.clear();
+  BOOST_CHECK_EQUAL(hasher.size(), 0);
+  BOOST_CHECK(hasher.getHash() == hash::zero);
+  hasher.push('x');
+  BOOST_CHECK(hasher.getHash() == hash::hash("x"));
+
+  BOOST_CHECK_THROW(RollingHasher(0), std::invalid_argument);
+}
+
+template <typename Backend, typename Mode>
+void CheckWindows(const std::string& text, size_t window) {
+  using hash_type = typename Backend::hash_type;
+  BasicHasher<Backend, Mode> hasher(text.begin(), text.end());
+  BasicRollingHasher<Backend, Mode> rolling(window);
+
+  const size_t count = text.size() >= window? text.size() - window + 1 : 0;
+  std::vector<hash_type> windows(count + 1, Backend::one());
+  BOOST_CHECK_EQUAL((HashWindows<Backend, Mode>(text.begin(), text.end(), window, windows.data())), count);
+  BOOST_CHECK(windows[count] == Backend::one());
+
+  // the same from list, ie by forward iterators
+  std::list<char> list(text.begin(), text.end());
+  std::vector<hash_type> list_windows(count);
+  BOOST_CHECK_EQUAL((HashWindows<Backend, Mode>(list.begin(), list.end(), window, list_windows.data())), count);
+
+  for (uint32 i = 0; i < text.size(); i++) {
+    rolling.push(text[i]);
+    const uint32 length = uint32(std::min<size_t>(i + 1, window));
+    BOOST_CHECK(rolling.getHash() == hasher.getHash(i + 1 - length, length));
+    if (length == window) {
+      BOOST_CHECK(windows[i + 1 - window] == rolling.getHash());
+      BOOST_CHECK(list_windows[i + 1 - window] == rolling.getHash());
+    }
+  }
+}
+
+template <typename Backend>
+void CheckBackend() {
+  std::string text;
+  for (int i = 0; i < 2000; i++)
+    text += char('a' + Random32() % 3);
+
+  for (size_t window: {1, 2, 3, 10, 499, 500, 501, 1999, 2000, 2001}) {
+    CheckWindows<Backend, hash::compatible>(text, window);
+    CheckWindows<Backend, hash::inverse_free>(text, window);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(hash_windows_test) {
+  CheckBackend<hash::prime_pair>();
+  CheckBackend<hash::mersenne61>();
+
+  {
+    std::string text = "abcab";
+    std::vector<hash::hash_type> windows(3);
+    BOOST_CHECK_EQUAL(HashWindows(text.begin(), text.end(), 3, windows.data()), 3);
+    BOOST_CHECK(windows[0] == hash::hash("abc"));
+    BOOST_CHECK(windows[2] == hash::hash("cab"));
+    BOOST_CHECK_THROW(HashWindows(text.begin(), text.end(), 0, windows.data()), std::invalid_argument);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,107 @@
+// Jakub Staroń, 2016
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+#include "text_algorithms/suffix_array.h"
+
+using namespace lib;
+
+BOOST_AUTO_TEST_SUITE(suffix_array_test)
+
+std::vector<uint32> NaiveSuffixArray(const std::vector<uint32>& text) {
+  std::vector<uint32> result(text.size());
+  std::iota(result.begin(), result.end(), 0);
+  std::sort(result.begin(), result.end(), [&text](uint32 lhs, uint32 rhs) {
+    return std::lexicographical_compare(text.begin() + lhs, text.end(), text.begin() + rhs, text.end());
+  });
+  return result;
+}
+
+/**
+ * Bytes are compared as unsigned chars.
+ */
+std::vector<uint32> NaiveSuffixArray(const std::string& text) {
+  std::vector<uint32> result(text.size());
+  std::iota(result.begin(), result.end(), 0);
+  std::sort(result.begin(), result.end(), [&text](uint32 lhs, uint32 rhs) {
+    return text.compare(lhs, std::string::npos, text, rhs, std::string::npos) < 0;
+  });
+  return result;
+}
+
+template <typename Sequence>
+uint32 NaiveLcp(const Sequence& text, uint32 lhs, uint32 rhs) {
+  uint32 length = 0;
+  while (lhs + length < text.size() && rhs + length < text.size() && text[lhs + length] == text[rhs + length])
+    length++;
+  return length;
+}
+
+template <typename Sequence>
+void CheckLcp(const Sequence& text, const std::vector<uint32>& suffix_array) {
+  const auto lcp = BuildLcpArray(text.begin(), text.end(), suffix_array);
+  BOOST_REQUIRE_EQUAL(lcp.size(), text.size());
+  for (uint32 i = 1; i < lcp.size(); i++)
+    BOOST_CHECK_EQUAL(lcp[i], NaiveLcp(text, suffix_array[i - 1], suffix_array[i]));
+}
+
+BOOST_AUTO_TEST_CASE(suffix_array_test) {
+  {
+    std::string text = "banana";
+    std::vector<uint32> expected = {5, 3, 1, 0, 4, 2};
+    BOOST_CHECK(BuildSuffixArray(text) == expected);
+    BOOST_CHECK(BuildSuffixArray(text.begin(), text.end()) == expected);
+    std::vector<uint32> expected_lcp = {0, 1, 3, 0, 0, 2};
+    BOOST_CHECK(BuildLcpArray(text.begin(), text.end(), expected) == expected_lcp);
+  }
+
+  BOOST_CHECK(BuildSuffixArray("").empty());
+  BOOST_CHECK(BuildSuffixArray("a") == std::vector<uint32>{0});
+  BOOST_CHECK((BuildSuffixArray("aaaa") == std::vector<uint32>{3, 2, 1, 0}));
+  BOOST_CHECK_THROW(BuildSuffixArray(std::vector<uint32>{0, 3}, 3), std::invalid_argument);
+
+  for (int test = 0; test < 300; test++) {
+    std::string text;
+    const uint32 alphabet = 1 + Random32() % 4;
+    for (uint32 i = Random32() % 200; i > 0; i--)
+      text += char(alphabet == 4? Random32() : 'a' + Random32() % alphabet);
+    const auto suffix_array = BuildSuffixArray(text);
+    BOOST_CHECK(suffix_array == NaiveSuffixArray(text));
+    CheckLcp(text, suffix_array);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(integer_alphabet_test) {
+  for (int test = 0; test < 100; test++) {
+    const uint32 alphabet = 1 + Random32() % 1000;
+    std::vector<uint32> text(Random32() % 300);
+    for (auto& letter: text)
+      letter = Random32() % alphabet;
+    const auto suffix_array = BuildSuffixArray(text, alphabet);
+    BOOST_CHECK(suffix_array == NaiveSuffixArray(text));
+    CheckLcp(text, suffix_array);
+  }
+
+  // periodic text has deep recursion
+  std::string text;
+  for (int i = 0; i < 5000; i++)
+    text += "abaab"[i % 5];
+  BOOST_CHECK(BuildSuffixArray(text) == NaiveSuffixArray(text));
+}
+
+BOOST_AUTO_TEST_CASE(longest_common_prefix_query_test) {
+  std::string text;
+  for (int i = 0; i < 500; i++)
+    text += char('a' + Random32() % 2);
+  const auto suffix_array = BuildSuffixArray(text);
+  LongestCommonPrefixQuery query(suffix_array, BuildLcpArray(text.begin(), text.end(), suffix_array));
+  for (int i = 0; i < 2000; i++) {
+    const uint32 lhs = Random32() % text.size(), rhs = Random32() % text.size();
+    BOOST_CHECK_EQUAL(query.longestCommonPrefix(lhs, rhs), NaiveLcp(text, lhs, rhs));
+  }
+  BOOST_CHECK_EQUAL(query.rank(suffix_array[7]), 7);
+  BOOST_CHECK_THROW(query.longestCommonPrefix(0, 500), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
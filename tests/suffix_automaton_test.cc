@@ -0,0 +1,124 @@
+// Jakub Staroń, 2016
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+#include "text_algorithms/suffix_automaton.h"
+
+using namespace lib;
+
+BOOST_AUTO_TEST_SUITE(suffix_automaton_test)
+
+uint64 NaiveOccurrences(const std::string& text, const std::string& pattern) {
+  uint64 result = 0;
+  for (size_t position = 0; position + pattern.size() <= text.size(); position++)
+    result += text.compare(position, pattern.size(), pattern) == 0;
+  return result;
+}
+
+uint32 NaiveLongestCommonSubstring(const std::string& first, const std::string& second) {
+  uint32 result = 0;
+  for (size_t i = 0; i < first.size(); i++) {
+    for (size_t j = 0; j < second.size(); j++) {
+      uint32 length = 0;
+      while (i + length < first.size() && j + length < second.size() && first[i + length] == second[j + length])
+        length++;
+      result = std::max(result, length);
+    }
+  }
+  return result;
+}
+
+BOOST_AUTO_TEST_CASE(simple_test) {
+  std::string text = "abcbc";
+  SuffixAutomaton automaton(text.begin(), text.end());
+  BOOST_CHECK_EQUAL(automaton.size(), 5);
+  BOOST_CHECK_EQUAL(automaton.distinctSubstrings(), 12);
+
+  std::string pattern = "bc";
+  BOOST_CHECK(automaton.contains(pattern.begin(), pattern.end()));
+  BOOST_CHECK_EQUAL(automaton.occurrences(pattern.begin(), pattern.end()), 2);
+  pattern = "ca";
+  BOOST_CHECK(!automaton.contains(pattern.begin(), pattern.end()));
+  BOOST_CHECK_EQUAL(automaton.occurrences(pattern.begin(), pattern.end()), 0);
+  pattern = "";
+  BOOST_CHECK_EQUAL(automaton.occurrences(pattern.begin(), pattern.end()), 6);
+
+  // counts are recomputed after push
+  automaton.push('b');
+  pattern = "b";
+  BOOST_CHECK_EQUAL(automaton.occurrences(pattern.begin(), pattern.end()), 3);
+
+  std::string other = "xxcbcbx";
+  BOOST_CHECK((automaton.longestCommonSubstring(other.begin(), other.end()) == std::make_pair(uint64(2), 4u)));
+
+  SuffixAutomaton empty;
+  BOOST_CHECK_EQUAL(empty.states(), 1);
+  BOOST_CHECK_EQUAL(empty.distinctSubstrings(), 0);
+  BOOST_CHECK((empty.longestCommonSubstring(other.begin(), other.end()).second == 0));
+}
+
+BOOST_AUTO_TEST_CASE(random_test) {
+  for (uint32 alphabet: {1, 2, 3, 26}) {
+    std::string text;
+    SuffixAutomaton automaton;
+    for (uint32 length = 1; length <= 150; length++) {
+      const char letter = char('a' + Random32() % alphabet);
+      text += letter;
+      automaton.push(letter);
+      BOOST_CHECK_LE(automaton.states(), std::max(2u, 2 * length - 1));
+      BOOST_CHECK_LE(automaton.edges(), std::max(3u, 3 * length - 4));
+      if (length % 30 != 0)
+        continue;
+
+      std::set<std::string> substrings;
+      for (size_t i = 0; i < text.size(); i++)
+        for (size_t j = i + 1; j <= text.size(); j++)
+          substrings.insert(text.substr(i, j - i));
+      BOOST_CHECK_EQUAL(automaton.distinctSubstrings(), substrings.size());
+
+      for (int i = 0; i < 50; i++) {
+        std::string pattern;
+        for (uint32 k = Random32() % 5; k > 0; k--)
+          pattern += char('a' + Random32() % (alphabet + 1));
+        const uint64 expected = pattern.empty()? text.size() + 1 : NaiveOccurrences(text, pattern);
+        BOOST_CHECK_EQUAL(automaton.occurrences(pattern.begin(), pattern.end()), expected);
+        BOOST_CHECK_EQUAL(automaton.contains(pattern.begin(), pattern.end()), expected > 0);
+      }
+
+      std::string other;
+      for (int i = 0; i < 40; i++)
+        other += char('a' + Random32() % (alphabet + 1));
+      const auto common = automaton.longestCommonSubstring(other.begin(), other.end());
+      BOOST_CHECK_EQUAL(common.second, NaiveLongestCommonSubstring(text, other));
+      BOOST_CHECK(text.find(other.substr(common.first, common.second)) != std::string::npos);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(large_alphabet_test) {
+  // states of large degree use binary search and blocks of many size classes
+  for (uint32 alphabet: {64, 256}) {
+    std::string text;
+    for (int i = 0; i < 4000; i++)
+      text += char(Random32() % alphabet);
+    SuffixAutomaton automaton(text.begin(), text.end());
+    BOOST_CHECK_LE(automaton.states(), 2 * text.size() - 1);
+    BOOST_CHECK_LE(automaton.edges(), 3 * text.size() - 4);
+
+    for (int i = 0; i < 500; i++) {
+      std::string pattern;
+      if (i % 2 == 0) {
+        const size_t position = Random32() % text.size();
+        pattern = text.substr(position, 1 + Random32() % 3);
+      }
+      else {
+        for (uint32 k = 1 + Random32() % 3; k > 0; k--)
+          pattern += char(Random32() % alphabet);
+      }
+      BOOST_CHECK_EQUAL(automaton.occurrences(pattern.begin(), pattern.end()), NaiveOccurrences(text, pattern));
+    }
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
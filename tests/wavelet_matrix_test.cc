@@ -0,0 +1,54 @@
+// Jakub Staroń, 2016
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+#include "data_structures/wavelet_matrix.h"
+
+using namespace lib;
+
+BOOST_AUTO_TEST_SUITE(wavelet_matrix_test)
+
+BOOST_AUTO_TEST_CASE(simple_test) {
+  std::vector<uint32> values = {3, 1, 3, 0};
+  WaveletMatrix matrix(values.begin(), values.end(), 2);
+  BOOST_CHECK_EQUAL(matrix.size(), 4);
+  BOOST_CHECK_EQUAL(matrix[0], 3);
+  BOOST_CHECK_EQUAL(matrix[3], 0);
+  BOOST_CHECK_EQUAL(matrix.rank(3, 3), 2);
+  BOOST_CHECK_EQUAL(matrix.rank(2, 4), 0);
+  BOOST_CHECK_EQUAL(matrix.rank(7, 4), 0);
+  BOOST_CHECK(matrix.accessRank(2) == std::make_pair(3u, 1u));
+
+  BOOST_CHECK_THROW(WaveletMatrix(values.begin(), values.end(), 1), std::invalid_argument);
+  BOOST_CHECK_THROW(WaveletMatrix(values.begin(), values.end(), 0), std::invalid_argument);
+}
+
+void CheckRandom(uint32 size, uint32 bits, uint32 range) {
+  std::vector<uint32> values(size);
+  for (auto& value: values)
+    value = Random32() % range;
+  WaveletMatrix matrix(values.begin(), values.end(), bits);
+
+  std::map<uint32, uint32> counts;
+  for (uint32 i = 0; i <= size; i++) {
+    for (uint32 value: {0u, 1u, range / 2, range - 1, range})
+      BOOST_CHECK_EQUAL(matrix.rank(value, i), counts[value]);
+    if (i < size) {
+      BOOST_CHECK_EQUAL(matrix[i], values[i]);
+      BOOST_CHECK(matrix.accessRank(i) == std::make_pair(values[i], counts[values[i]]));
+      counts[values[i]]++;
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(random_test) {
+  CheckRandom(1000, 1, 2);
+  CheckRandom(1000, 3, 5);
+  CheckRandom(2000, 8, 256);
+  // without table of starts
+  CheckRandom(1000, 20, 7);
+  CheckRandom(1000, 32, 1000000);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,272 @@
+#pragma once
+// Jakub Staroń, 2016
+
+#include "headers.h"
+
+namespace lib {
+
+/**
+ * Aho-Corasick automaton finding occurrences of many patterns in one pass over text.
+ *
+ * Patterns and texts are sequences of bytes (elements are converted
+ * to unsigned char). Only letters which occur in patterns are kept in
+ * the automaton, other ones move it to the root.
+ *
+ * Nodes are numbered in BFS order and all of them are kept in flat arrays:
+ * - if alphabet of patterns has at most dense_alphabet letters, the whole
+ *   transition function (with failure links resolved) is precomputed,
+ *   so every letter of text costs one lookup,
+ * - otherwise edges of trie are kept in one array sorted by node and letter,
+ *   and failure links are followed while matching, only transitions
+ *   of root are kept in a table.
+ *
+ * Every node keeps number of patterns which are its suffixes, so count
+ * takes constant time per letter, and dictionary suffix link to the
+ * nearest proper suffix which is a pattern, used by find to report
+ * only real matches.
+ *
+ * Example:
+ * <pre>
+ * std::vector<std::string> patterns = {"he", "she", "his", "hers"};
+ * AhoCorasick automaton(patterns.begin(), patterns.end());
+ * automaton.count(text.begin(), text.end());
+ * automaton.find(text.begin(), text.end(), [](uint32 pattern, uint64 offset) { ... });
+ * </pre>
+ */
+class AhoCorasick {
+public:
+  static constexpr uint32 kDenseAlphabetSize = 32;
+
+  /**
+   * Builds automaton of patterns given by range of sequences (ie types with begin() and end()).
+   * Patterns are numbered in order of the range, equal patterns are allowed.
+   *
+   * Throws an std::invalid_argument if some pattern is empty.
+   */
+  template <typename Iterator>
+  AhoCorasick(Iterator patterns_begin, Iterator patterns_end, uint32 dense_alphabet = kDenseAlphabetSize) {
+    buildAlphabet(patterns_begin, patterns_end);
+    std::vector<std::vector<std::pair<uint8, uint32>>> children(1);
+    std::vector<std::vector<uint32>> outputs(1);
+    for (; patterns_begin != patterns_end; ++patterns_begin) {
+      uint32 node = 0, length = 0;
+      for (const auto& value: *patterns_begin) {
+        node = TrieChild(children, node, uint8(letters_[uint8(value)]));
+        length++;
+      }
+      if (length == 0)
+        throw std::invalid_argument("AhoCorasick - empty pattern");
+      outputs.resize(children.size());
+      outputs[node].push_back(uint32(lengths_.size()));
+      lengths_.push_back(length);
+    }
+    outputs.resize(children.size());
+    buildNodes(children, outputs);
+    if (alphabet_size_ <= dense_alphabet)
+      buildTransitions();
+  }
+
+  /**
+   * Returns number of occurrences of all patterns in text.
+   */
+  template <typename Iterator>
+  uint64 count(Iterator begin, Iterator end) const {
+    uint64 result = 0;
+    if (dense()) {
+      const uint32* transitions = transitions_.data();
+      const uint32 width = alphabet_size_ + 1;
+      uint32 node = 0;
+      for (; begin != end; ++begin) {
+        node = transitions[node * width + letters_[uint8(*begin)]];
+        result += matches_[node];
+      }
+    }
+    else {
+      uint32 node = 0;
+      for (; begin != end; ++begin) {
+        node = next(node, letters_[uint8(*begin)]);
+        result += matches_[node];
+      }
+    }
+    return result;
+  }
+
+  /**
+   * Calls on_match(pattern, offset) for every occurrence of pattern
+   * in text, offset is position of its first element. Occurrences
+   * are reported in order of their ends.
+   */
+  template <typename Iterator, typename Function>
+  void find(Iterator begin, Iterator end, Function on_match) const {
+    const uint32 width = alphabet_size_ + 1;
+    uint32 node = 0;
+    for (uint64 position = 1; begin != end; ++begin, ++position) {
+      const uint32 letter = letters_[uint8(*begin)];
+      node = dense()? transitions_[node * width + letter] : next(node, letter);
+      if (matches_[node] == 0)
+        continue;
+      for (uint32 v = output_begin_[node] != output_begin_[node + 1]? node : dictionary_[node];
+           v != kNone; v = dictionary_[v]) {
+        for (uint32 i = output_begin_[v]; i < output_begin_[v + 1]; i++)
+          on_match(outputs_[i], position - lengths_[outputs_[i]]);
+      }
+    }
+  }
+
+  /**
+   * Returns number of patterns.
+   */
+  uint32 patterns() const {
+    return uint32(lengths_.size());
+  }
+
+  /**
+   * Returns number of nodes of automaton.
+   */
+  uint32 size() const {
+    return uint32(fail_.size());
+  }
+
+  /**
+   * Returns true if whole transition function is precomputed.
+   */
+  bool dense() const {
+    return !transitions_.empty();
+  }
+
+private:
+  static constexpr uint32 kNone = std::numeric_limits<uint32>::max();
+  static constexpr uint32 kLinearSearchDegree = 8;
+
+  template <typename Iterator>
+  void buildAlphabet(Iterator patterns_begin, Iterator patterns_end) {
+    std::fill(std::begin(letters_), std::end(letters_), 0);
+    for (; patterns_begin != patterns_end; ++patterns_begin)
+      for (const auto& value: *patterns_begin)
+        letters_[uint8(value)] = 1;
+    alphabet_size_ = 0;
+    for (auto& letter: letters_)
+      letter = letter? alphabet_size_++ : kNone;
+    // letters outside of alphabet are mapped to alphabet_size_
+    for (auto& letter: letters_)
+      if (letter == kNone)
+        letter = alphabet_size_;
+  }
+
+  static uint32 TrieChild(std::vector<std::vector<std::pair<uint8, uint32>>>& children, uint32 node, uint8 letter) {
+    for (const auto& edge: children[node])
+      if (edge.first == letter)
+        return edge.second;
+    const uint32 child = uint32(children.size());
+    children[node].emplace_back(letter, child);
+    children.emplace_back();
+    return child;
+  }
+
+  /**
+   * Renumbers trie in BFS order, fills flat arrays of edges and outputs,
+   * computes failure links, dictionary suffix links and numbers of matches.
+   */
+  void buildNodes(std::vector<std::vector<std::pair<uint8, uint32>>>& children,
+                  const std::vector<std::vector<uint32>>& outputs) {
+    const uint32 nodes = uint32(children.size());
+    std::vector<uint32> order = {0};
+    std::vector<uint32> number(nodes);
+    for (uint32 i = 0; i < order.size(); i++) {
+      number[order[i]] = i;
+      auto& edges = children[order[i]];
+      std::sort(edges.begin(), edges.end());
+      for (const auto& edge: edges)
+        order.push_back(edge.second);
+    }
+
+    edge_begin_.assign(nodes + 1, 0);
+    output_begin_.assign(nodes + 1, 0);
+    for (uint32 i = 0; i < nodes; i++) {
+      for (const auto& edge: children[order[i]]) {
+        edge_letters_.push_back(edge.first);
+        edge_targets_.push_back(number[edge.second]);
+      }
+      edge_begin_[i + 1] = uint32(edge_letters_.size());
+      outputs_.insert(outputs_.end(), outputs[order[i]].begin(), outputs[order[i]].end());
+      output_begin_[i + 1] = uint32(outputs_.size());
+    }
+
+    // every chain of failure links ends with lookup in root_
+    root_.assign(alphabet_size_ + 1, 0);
+    for (uint32 i = edge_begin_[0]; i < edge_begin_[1]; i++)
+      root_[edge_letters_[i]] = edge_targets_[i];
+
+    // parents are before children in BFS order
+    fail_.assign(nodes, 0);
+    dictionary_.assign(nodes, uint32(kNone));
+    matches_.assign(nodes, 0);
+    for (uint32 node = 0; node < nodes; node++) {
+      if (node != 0) {
+        const uint32 fail = fail_[node];
+        dictionary_[node] = output_begin_[fail] != output_begin_[fail + 1]? fail : dictionary_[fail];
+        matches_[node] = output_begin_[node + 1] - output_begin_[node] + matches_[fail];
+      }
+      for (uint32 i = edge_begin_[node]; i < edge_begin_[node + 1]; i++)
+        fail_[edge_targets_[i]] = node == 0? 0 : next(fail_[node], edge_letters_[i]);
+    }
+  }
+
+  void buildTransitions() {
+    const uint32 width = alphabet_size_ + 1;
+    transitions_.assign(size_t(size()) * width, 0);
+    // failure links point to earlier nodes, so their rows are complete
+    for (uint32 node = 0; node < size(); node++) {
+      uint32* row = transitions_.data() + size_t(node) * width;
+      if (node != 0)
+        std::copy_n(transitions_.data() + size_t(fail_[node]) * width, width, row);
+      for (uint32 i = edge_begin_[node]; i < edge_begin_[node + 1]; i++)
+        row[edge_letters_[i]] = edge_targets_[i];
+    }
+  }
+
+  /**
+   * Returns child of node by letter or kNone.
+   */
+  uint32 child(uint32 node, uint32 letter) const {
+    const uint8* begin = edge_letters_.data() + edge_begin_[node];
+    const uint8* end = edge_letters_.data() + edge_begin_[node + 1];
+    const uint8* it = begin;
+    if (uint32(end - begin) <= kLinearSearchDegree) {
+      while (it != end && *it < letter)
+        ++it;
+    }
+    else {
+      it = std::lower_bound(begin, end, letter);
+    }
+    return it != end && *it == letter? edge_targets_[it - edge_letters_.data()] : kNone;
+  }
+
+  /**
+   * Returns node after reading letter in node, following failure links.
+   */
+  uint32 next(uint32 node, uint32 letter) const {
+    for (; node != 0; node = fail_[node]) {
+      const uint32 target = child(node, letter);
+      if (target != kNone)
+        return target;
+    }
+    return root_[letter];
+  }
+
+  uint32 letters_[256];
+  uint32 alphabet_size_;
+  std::vector<uint32> lengths_;
+  std::vector<uint32> edge_begin_;
+  std::vector<uint8> edge_letters_;
+  std::vector<uint32> edge_targets_;
+  std::vector<uint32> output_begin_;
+  std::vector<uint32> outputs_;
+  std::vector<uint32> root_;
+  std::vector<uint32> fail_;
+  std::vector<uint32> dictionary_;
+  std::vector<uint32> matches_;
+  std::vector<uint32> transitions_;
+};
+
+} // namespace lib
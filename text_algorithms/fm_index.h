@@ -0,0 +1,189 @@
+#pragma once
+// Jakub Staroń, 2016
+
+#include "headers.h"
+#include "data_structures/rank_bit_vector.h"
+#include "data_structures/wavelet_matrix.h"
+#include "text_algorithms/suffix_array.h"
+
+namespace lib {
+
+/**
+ * FM-index of a sequence of bytes (elements are converted to unsigned char),
+ * counts and locates occurrences of patterns without keeping the text.
+ *
+ * Burrows-Wheeler transform of text$ is computed from suffix array built
+ * by SA-IS and kept in WaveletMatrix over letters of text (with code 0
+ * for $), so one step of backward search takes two ranks of bits bits
+ * each, where bits = ceil(log2(alphabet_size + 1)). Every sample_rate-th
+ * position of text is sampled, locating one occurrence takes at most
+ * sample_rate - 1 steps of LF mapping.
+ *
+ * Memory is about (8 * bits / 7 + 32 / sample_rate + 8 / 7) / 8 bytes
+ * per letter, eg 0.7 byte for DNA and sample_rate 32. Suffix array
+ * is needed only during construction.
+ *
+ * Example:
+ * <pre>
+ * FMIndex index(text);
+ * index.count("abra"); // number of occurrences
+ * index.locate("abra"); // their positions
+ * </pre>
+ */
+class FMIndex {
+public:
+  static constexpr uint32 kSampleRate = 32;
+
+  /**
+   * Throws an std::invalid_argument if sample_rate is 0.
+   */
+  template <typename Iterator>
+  FMIndex(Iterator begin, Iterator end, uint32 sample_rate = kSampleRate) {
+    std::vector<uint8> text;
+    text.reserve(std::distance(begin, end));
+    for (; begin != end; ++begin)
+      text.push_back(uint8(*begin));
+    build(text.data(), text.size(), sample_rate);
+  }
+
+  /**
+   * Builds index of string without copying it.
+   */
+  explicit FMIndex(const std::string& text, uint32 sample_rate = kSampleRate) {
+    build(reinterpret_cast<const uint8*>(text.data()), text.size(), sample_rate);
+  }
+
+  /**
+   * Returns number of occurrences of pattern given by bidirectional iterators
+   * in O(length of pattern) time. Empty pattern occurs size() + 1 times.
+   */
+  template <typename Iterator>
+  uint64 count(Iterator begin, Iterator end) const {
+    const auto rows = range(begin, end);
+    return rows.second - rows.first;
+  }
+
+  uint64 count(const std::string& pattern) const {
+    return count(pattern.begin(), pattern.end());
+  }
+
+  /**
+   * Returns sorted positions of occurrences of pattern.
+   */
+  template <typename Iterator>
+  std::vector<uint32> locate(Iterator begin, Iterator end) const {
+    const auto rows = range(begin, end);
+    std::vector<uint32> result;
+    result.reserve(rows.second - rows.first);
+    for (uint32 row = rows.first; row < rows.second; row++)
+      result.push_back(position(row));
+    std::sort(result.begin(), result.end());
+    return result;
+  }
+
+  std::vector<uint32> locate(const std::string& pattern) const {
+    return locate(pattern.begin(), pattern.end());
+  }
+
+  /**
+   * Returns length of text.
+   */
+  uint32 size() const {
+    return bwt_.size() - 1;
+  }
+
+  /**
+   * Returns memory used by index in bytes.
+   */
+  size_t bytes() const {
+    return bwt_.bytes() + sampled_.bytes() + samples_.size() * sizeof(uint32) +
+        sizeof(codes_) + starts_.size() * sizeof(uint32);
+  }
+
+private:
+  static constexpr uint32 kNoCode = std::numeric_limits<uint32>::max();
+
+  void build(const uint8* text, size_t n, uint32 sample_rate) {
+    if (sample_rate == 0)
+      throw std::invalid_argument("FMIndex - sample rate must be positive");
+    if (n >= std::numeric_limits<uint32>::max() - 1)
+      throw std::invalid_argument("FMIndex - text is too long");
+    const uint32 length = uint32(n);
+
+    // letters of text get codes 1, 2, ... in their order, $ is 0
+    std::fill(std::begin(codes_), std::end(codes_), 0);
+    for (uint32 i = 0; i < length; i++)
+      codes_[text[i]] = 1;
+    uint32 alphabet_size = 1;
+    for (auto& code: codes_)
+      code = code? alphabet_size++ : kNoCode;
+    uint32 bits = 1;
+    while ((uint32(1) << bits) < alphabet_size)
+      bits++;
+
+    // rows of BWT are suffixes of text$, the first one is $
+    std::vector<uint32> suffix_array(length);
+    detail::InducedSort(text, length, 256, suffix_array.data());
+    // codes need 9 bits if text contains all 256 bytes
+    std::vector<uint16> bwt(length + 1);
+    std::vector<bool> sampled(length + 1);
+    bwt[0] = uint16(length > 0? codes_[text[length - 1]] : 0);
+    sampled[0] = length % sample_rate == 0;
+    if (sampled[0])
+      samples_.push_back(length);
+    for (uint32 i = 0; i < length; i++) {
+      const uint32 position = suffix_array[i];
+      bwt[i + 1] = uint16(position > 0? codes_[text[position - 1]] : 0);
+      sampled[i + 1] = position % sample_rate == 0;
+      if (sampled[i + 1])
+        samples_.push_back(position);
+    }
+    std::vector<uint32>().swap(suffix_array);
+
+    starts_.assign(alphabet_size + 1, 0);
+    for (uint16 code: bwt)
+      starts_[code + 1]++;
+    std::partial_sum(starts_.begin(), starts_.end(), starts_.begin());
+
+    bwt_ = WaveletMatrix(bwt.begin(), bwt.end(), bits);
+    sampled_ = RankBitVector(sampled.begin(), sampled.end());
+  }
+
+  /**
+   * Returns rows of BWT which start with pattern, by backward search.
+   */
+  template <typename Iterator>
+  std::pair<uint32, uint32> range(Iterator begin, Iterator end) const {
+    uint32 first = 0, last = bwt_.size();
+    while (end != begin && first < last) {
+      --end;
+      const uint32 code = codes_[uint8(*end)];
+      if (code == kNoCode)
+        return std::make_pair(0, 0);
+      first = starts_[code] + bwt_.rank(code, first);
+      last = starts_[code] + bwt_.rank(code, last);
+    }
+    return first < last? std::make_pair(first, last) : std::make_pair(0u, 0u);
+  }
+
+  /**
+   * Returns position of suffix in row of BWT, following LF mapping
+   * to the nearest sampled row.
+   */
+  uint32 position(uint32 row) const {
+    uint32 steps = 0;
+    for (; !sampled_[row]; steps++) {
+      const auto code_rank = bwt_.accessRank(row);
+      row = starts_[code_rank.first] + code_rank.second;
+    }
+    return samples_[sampled_.rank(row)] + steps;
+  }
+
+  uint32 codes_[256];
+  std::vector<uint32> starts_;
+  WaveletMatrix bwt_;
+  RankBitVector sampled_;
+  std::vector<uint32> samples_;
+};
+
+} // namespace lib
@@ -5,6 +5,73 @@
 
 namespace lib {
 
+namespace hash {
+
+/**
+ * Hasher mode in which getHash(v) is equal to hash::hash<Backend>(v).
+ * Uses powers of inverse of base.
+ */
+struct compatible { };
+
+/**
+ * Hasher mode without inverses, prefix hashes are computed with
+ * Horner scheme and getHash(begin, length) = h[begin + length] - h[begin] * base^length.
+ * Result is equal to hash::hash<Backend> of reversed subsequence.
+ */
+struct inverse_free { };
+
+} // namespace hash
+
+namespace detail {
+
+/**
+ * Returns table of at least size powers of Backend::base()
+ * (or of its inverse, if inverse is true).
+ *
+ * Table is shared by all hashers with the same backend which use it
+ * at the same time and is freed with the last of them, only weak pointer
+ * is cached. When longer table is needed, it's extended (at least twice)
+ * into new table, hashers keep pointer to their table, so extending
+ * doesn't invalidate tables in use.
+ */
+template <typename Backend, bool inverse>
+std::shared_ptr<const std::vector<typename Backend::hash_type>> BasePowers(size_t size) {
+  using hash_type = typename Backend::hash_type;
+  static std::mutex mutex;
+  static std::weak_ptr<const std::vector<hash_type>> cache;
+
+  std::lock_guard<std::mutex> lock(mutex);
+  std::shared_ptr<const std::vector<hash_type>> table = cache.lock();
+  if (!table || table->size() < size) {
+    auto extended = std::make_shared<std::vector<hash_type>>();
+    const size_t new_size = table? std::max(size, 2 * table->size()) : std::max(size, size_t(1));
+    extended->reserve(new_size);
+    if (table)
+      extended->assign(table->begin(), table->end());
+    else
+      extended->push_back(Backend::one());
+    const size_t old_size = extended->size();
+    extended->resize(new_size);
+    hash_type* powers = extended->data();
+
+    // kStride independent chains of multiplications
+    constexpr size_t kStride = 8;
+    const hash_type ratio = inverse? Backend::inverse(Backend::base()) : Backend::base();
+    for (size_t i = old_size; i < std::min(new_size, kStride); i++)
+      powers[i] = Backend::multiply(powers[i - 1], ratio);
+    hash_type step = ratio;
+    for (size_t i = 1; i < kStride; i *= 2)
+      step = Backend::multiply(step, step);
+    for (size_t i = std::max(old_size, kStride); i < new_size; i++)
+      powers[i] = Backend::multiply(powers[i - kStride], step);
+    table = std::move(extended);
+    cache = table;
+  }
+  return table;
+}
+
+} // namespace detail
+
 /**
  * Data structure for computing hashes of substrings.
  *
@@ -13,16 +80,40 @@ namespace lib {
  * conversible to hash::scalar_type).
  *
  * Preprocess it in O(length) time.
- * Queries takes constant time.
+ * Queries takes constant time, ie one subtraction and one multiplication.
+ *
+ * Hasher stores prefix hashes, one hash per element, and keeps table
+ * of powers of inverse of base (compatible mode) or of base (inverse_free
+ * mode) at least as long as the sequence. Tables are shared between
+ * hashers with the same backend alive at the same time, sized for
+ * the longest of them, and freed with the last of them. So a single
+ * hasher takes two hashes per element, hashers of many sequences
+ * of similar length take about one.
  *
- * It's guaranteed, that if v is queried subsequence
- * then returned hash is equal to hash::hash(v), ie
- * we can use hasher to implement multipattern search.
+ * Backend selects hash arithmetic, hash::prime_pair (default)
+ * or hash::mersenne61, which keeps one 64 bits word per element.
+ *
+ * Mode selects normalization of hashes:
+ * - hash::compatible (default) - it's guaranteed, that if v is queried
+ *   subsequence then returned hash is equal to hash::hash<Backend>(v), ie
+ *   we can use hasher to implement multipattern search.
+ * - hash::inverse_free - returned hash is equal to hash::hash<Backend>
+ *   of reversed v, no inverse of base is computed.
+ *
+ * Example:
+ * <pre>
+ * BasicHasher<hash::mersenne61, hash::inverse_free> hasher(text.begin(), text.end());
+ * hasher.getHash(0, 3) == hasher.getHash(5, 3);
+ * hasher.equal(0, 5, 3); // the same, without computing hashes
+ * </pre>
  */
-class Hasher {
+template <typename Backend, typename Mode = hash::compatible>
+class BasicHasher {
 public:
-  using ptr = std::shared_ptr<Hasher>; /// Smart pointer to class
-  using hash_type = hash::hash_type;
+  using ptr = std::shared_ptr<BasicHasher>; /// Smart pointer to class
+  using backend_type = Backend;
+  using mode_type = Mode;
+  using hash_type = typename Backend::hash_type;
   using scalar_type = hash::scalar_type;
   using index_type = uint32;
 
@@ -33,53 +124,142 @@ public:
    * to hash::scalar_type.
    */
   template<typename Iterator>
-  Hasher(Iterator begin, Iterator end) {
+  BasicHasher(Iterator begin, Iterator end) {
     size_ = uint32(std::distance(begin, end));
-    preprocessInverses();
-
-    hashes_.reserve(size_ + 1);
-    hash_type sum = hash::zero;
-    hash_type power = hash::one;
-    hashes_.push_back(hash::zero);
-    for (const auto& elem: make_range(begin, end)) {
-      hash_type tmp = hash::multiply(power, scalar_type(elem));
-      sum = hash::add(sum, tmp);
-      hashes_.push_back(sum);
-      power = hash::multiply(power, hash::multipler);
-    }
+    preprocess(begin, end, Mode());
   }
 
-  Hasher(const Hasher&) = delete;
-  Hasher& operator=(const Hasher&) = delete;
+  BasicHasher(const BasicHasher&) = delete;
+  BasicHasher& operator=(const BasicHasher&) = delete;
 
-  Hasher(Hasher&& other):
-      inverses_(std::move(other.inverses_)),
-      hashes_(std::move(other.hashes_)) { }
+  BasicHasher(BasicHasher&& other):
+      table_(std::move(other.table_)),
+      powers_(other.powers_),
+      inverses_(other.inverses_),
+      hashes_(std::move(other.hashes_)),
+      size_(other.size_) { }
 
   /**
    * Returns hash of subsequence.
    */
   hash_type getHash(index_type begin, index_type length) const {
-    hash_type tmp = hash::subtract(hashes_[begin + length] , hashes_[begin]);
-    return hash::multiply(tmp, inverses_[begin]);
+    return getHash(begin, length, Mode());
+  }
+
+  /**
+   * Checks if subsequences of given length starting at
+   * begin1 and begin2 have equal hashes.
+   *
+   * Compares cross-multiplied prefix differences, so it costs
+   * one multiplication in both modes. It reads the same table
+   * as getHash: powers of inverse of base in compatible mode
+   * and powers of base in inverse_free mode.
+   */
+  bool equal(index_type begin1, index_type begin2, index_type length) const {
+    return equal(begin1, begin2, length, Mode());
   }
 
 private:
-  void preprocessInverses() {
-    inverses_.resize(size_ + 1);
-    inverses_[0] = hash::one;
-    const hash_type inverse = inverseHash(hash::multipler);
-    for(auto i: range(0u, size_))
-      inverses_[i + 1] = hash::multiply(inverses_[i], inverse);
+  /**
+   * Calls function(values, count, index) for consecutive blocks
+   * of elements converted to scalar_type, index is position of block.
+   */
+  template <typename Iterator, typename Function>
+  static void ForEachBlock(Iterator begin, Iterator end, Function function) {
+    scalar_type block[hash::detail::kHashBlockSize];
+    index_type index = 0;
+    while (begin != end) {
+      size_t count = 0;
+      for (; count < hash::detail::kHashBlockSize && begin != end; ++begin)
+        block[count++] = scalar_type(*begin);
+      function(block, count, index);
+      index += index_type(count);
+    }
   }
 
-  static hash_type inverseHash(const hash_type& hash) {
-    return {numeric::inverse(hash.first), numeric::inverse(hash.second)};
+  /**
+   * Terms values[i] * base^i are independent, so they are computed
+   * in bulk (SIMD if backend supports it) and then summed.
+   *
+   * Powers of base for the current block are kept in a block-sized
+   * buffer and moved to the next block by independent multiplications
+   * by base^kHashBlockSize, no table of length of sequence is needed.
+   */
+  template <typename Iterator>
+  void preprocess(Iterator begin, Iterator end, hash::compatible) {
+    table_ = detail::BasePowers<Backend, true>(size_ + 1);
+    powers_ = nullptr;
+    inverses_ = table_->data();
+
+    constexpr size_t kBlockSize = hash::detail::kHashBlockSize;
+    std::vector<hash_type> powers(kBlockSize);
+    powers[0] = Backend::one();
+    for (size_t i = 1; i < kBlockSize; i++)
+      powers[i] = Backend::multiply(powers[i - 1], Backend::base());
+    const hash_type step = Backend::multiply(powers[kBlockSize - 1], Backend::base());
+
+    hashes_.resize(size_ + 1, Backend::zero());
+    hash_type* hashes = hashes_.data();
+    ForEachBlock(begin, end, [&powers, step, hashes](const scalar_type* values, size_t count, index_type index) {
+      if (index > 0) {
+        for (auto& power: powers)
+          power = Backend::multiply(power, step);
+      }
+      Backend::multiplyAll(powers.data(), values, hashes + index + 1, count);
+      for (size_t i = index; i < index + count; i++)
+        hashes[i + 1] = Backend::add(hashes[i], hashes[i + 1]);
+    });
   }
 
-  std::vector<hash_type> inverses_;
+  /**
+   * Horner scheme is a chain of dependent multiplications,
+   * Backend::horner splits it into independent blocks.
+   */
+  template <typename Iterator>
+  void preprocess(Iterator begin, Iterator end, hash::inverse_free) {
+    table_ = detail::BasePowers<Backend, false>(std::max(size_t(size_), hash::detail::kHornerBlock) + 1);
+    powers_ = table_->data();
+    inverses_ = nullptr;
+    hashes_.resize(size_ + 1, Backend::zero());
+    hash_type* hashes = hashes_.data();
+    ForEachBlock(begin, end, [this, hashes](const scalar_type* values, size_t count, index_type index) {
+      Backend::horner(values, count, hashes[index], powers_, hashes + index + 1);
+    });
+  }
+
+  hash_type getHash(index_type begin, index_type length, hash::compatible) const {
+    hash_type tmp = Backend::subtract(hashes_[begin + length] , hashes_[begin]);
+    return Backend::multiply(tmp, inverses_[begin]);
+  }
+
+  hash_type getHash(index_type begin, index_type length, hash::inverse_free) const {
+    return Backend::subtract(hashes_[begin + length], Backend::multiply(hashes_[begin], powers_[length]));
+  }
+
+  bool equal(index_type begin1, index_type begin2, index_type length, hash::compatible) const {
+    if (begin1 > begin2)
+      std::swap(begin1, begin2);
+    // hashes_ differences are hashes multiplied by base^begin
+    hash_type lhs = Backend::subtract(hashes_[begin1 + length], hashes_[begin1]);
+    hash_type rhs = Backend::subtract(hashes_[begin2 + length], hashes_[begin2]);
+    return lhs == Backend::multiply(rhs, inverses_[begin2 - begin1]);
+  }
+
+  bool equal(index_type begin1, index_type begin2, index_type length, hash::inverse_free) const {
+    // h[b1 + l] - h[b1] B^l = h[b2 + l] - h[b2] B^l
+    hash_type lhs = Backend::subtract(hashes_[begin1 + length], hashes_[begin2 + length]);
+    hash_type rhs = Backend::subtract(hashes_[begin1], hashes_[begin2]);
+    return lhs == Backend::multiply(rhs, powers_[length]);
+  }
+
+  // powers of inverse of base in compatible mode, of base in inverse_free mode
+  std::shared_ptr<const std::vector<hash_type>> table_;
+  const hash_type* powers_;
+  const hash_type* inverses_;
   std::vector<hash_type> hashes_;
   index_type size_;
 };
 
+using Hasher = BasicHasher<hash::prime_pair>;
+
 } // namespace lib
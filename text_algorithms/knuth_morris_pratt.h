@@ -52,7 +52,8 @@ public:
   KnuthMorrisPratt &operator=(const KnuthMorrisPratt &) = delete;
 
   KnuthMorrisPratt(KnuthMorrisPratt &&other) :
-      P_(std::move(other.P_)) {}
+      P_(std::move(other.P_)),
+      borders_(std::move(other.borders_)) {}
 
   /**
    * Returns prefix-suffix array.
@@ -73,4 +74,226 @@ private:
   std::vector<uint32> borders_;
 };
 
+/**
+ * Finds occurrences of pattern in text given in chunks.
+ *
+ * State of the KMP automaton is kept between calls to feed,
+ * so text may be split into chunks at any place (for example
+ * buffers read from file) and matches crossing chunk borders
+ * are found. Offsets of matches are positions of their first
+ * elements in the whole text.
+ *
+ * Elements are compared with operator==. Each element takes
+ * amortized constant time, while matcher is at the beginning
+ * of pattern it skips to the next occurrence of its first element
+ * with std::find.
+ *
+ * Example:
+ * <pre>
+ * KnuthMorrisPrattMatcher<char> matcher(pattern.begin(), pattern.end());
+ * std::vector<uint64> matches;
+ * matcher.feed(chunk1.begin(), chunk1.end(), matches);
+ * matcher.feed(chunk2.begin(), chunk2.end(), [](uint64 offset) { ... });
+ * </pre>
+ */
+template <typename T>
+class KnuthMorrisPrattMatcher {
+public:
+  /**
+   * Builds matcher of pattern.
+   *
+   * Throws an std::invalid_argument if pattern is empty.
+   */
+  template <typename Iterator>
+  KnuthMorrisPrattMatcher(Iterator begin, Iterator end):
+      pattern_(begin, end),
+      state_(0),
+      position_(0) {
+    if (pattern_.empty())
+      throw std::invalid_argument("KnuthMorrisPrattMatcher - empty pattern");
+    P_ = KnuthMorrisPratt(pattern_.begin(), pattern_.end()).result();
+  }
+
+  /**
+   * Processes next chunk of text, calls on_match(offset)
+   * for every occurrence of pattern ending in this chunk.
+   */
+  template <typename Iterator, typename Function>
+  void feed(Iterator begin, Iterator end, Function on_match) {
+    const uint32 size = uint32(pattern_.size());
+    const T* pattern = pattern_.data();
+    const uint32* P = P_.data();
+    uint32 state = state_;
+    uint64 position = position_;
+    while (begin != end) {
+      if (state == 0) {
+        Iterator next = std::find(begin, end, pattern[0]);
+        position += uint64(std::distance(begin, next));
+        if ((begin = next) == end)
+          break;
+      }
+      const auto& value = *begin;
+      while (state > 0 && !(pattern[state] == value))
+        state = P[state];
+      if (pattern[state] == value)
+        state++;
+      ++begin;
+      position++;
+      if (state == size) {
+        on_match(position - size);
+        state = P[size];
+      }
+    }
+    state_ = state;
+    position_ = position;
+  }
+
+  /**
+   * Processes next chunk of text, appends offsets of occurrences to matches.
+   */
+  template <typename Iterator>
+  void feed(Iterator begin, Iterator end, std::vector<uint64>& matches) {
+    feed(begin, end, [&matches](uint64 offset) { matches.push_back(offset); });
+  }
+
+  /**
+   * Returns number of elements processed so far.
+   */
+  uint64 position() const {
+    return position_;
+  }
+
+  /**
+   * Forgets processed text.
+   */
+  void reset() {
+    state_ = 0;
+    position_ = 0;
+  }
+
+private:
+  std::vector<T> pattern_;
+  std::vector<uint32> P_;
+  uint32 state_;
+  uint64 position_;
+};
+
+/**
+ * KnuthMorrisPrattMatcher with precomputed transitions of automaton.
+ *
+ * Alphabet is a range of alphabet_size consecutive values starting
+ * at alphabet_first, transitions take (pattern length + 1) * (alphabet_size + 1)
+ * words, so it's intended for small alphabets. Every element of text
+ * takes one lookup, without fallback loop. Elements outside of alphabet
+ * are allowed in text and never match.
+ *
+ * Example:
+ * <pre>
+ * KnuthMorrisPrattAutomaton automaton(pattern.begin(), pattern.end(), 'a', 26);
+ * automaton.feed(chunk.begin(), chunk.end(), [](uint64 offset) { ... });
+ * </pre>
+ */
+class KnuthMorrisPrattAutomaton {
+public:
+  /**
+   * Builds automaton of pattern.
+   *
+   * Throws an std::invalid_argument if pattern is empty
+   * or contains value outside of alphabet.
+   */
+  template <typename Iterator>
+  KnuthMorrisPrattAutomaton(Iterator begin, Iterator end, int64 alphabet_first, uint32 alphabet_size):
+      alphabet_first_(alphabet_first),
+      alphabet_size_(alphabet_size),
+      state_(0),
+      position_(0) {
+    std::vector<uint32> pattern;
+    for (; begin != end; ++begin) {
+      const uint64 letter = index(*begin);
+      if (letter >= alphabet_size)
+        throw std::invalid_argument("KnuthMorrisPrattAutomaton - pattern outside of alphabet");
+      pattern.push_back(uint32(letter));
+    }
+    if (pattern.empty())
+      throw std::invalid_argument("KnuthMorrisPrattAutomaton - empty pattern");
+
+    const uint32 size = uint32(pattern.size());
+    const std::vector<uint32> P = KnuthMorrisPratt(pattern.begin(), pattern.end()).result();
+    // rows have additional column for values outside of alphabet and states
+    // are stored multiplied by width of row, ie as offsets of their rows
+    const uint32 width = alphabet_size + 1;
+    transitions_.assign(size_t(size + 1) * width, 0);
+    transitions_[pattern[0]] = width;
+    for (uint32 state = 1; state <= size; state++) {
+      uint32* row = transitions_.data() + size_t(state) * width;
+      std::copy_n(transitions_.data() + size_t(P[state]) * width, width, row);
+      if (state < size)
+        row[pattern[state]] = (state + 1) * width;
+    }
+    final_ = size * width;
+    size_ = size;
+  }
+
+  /**
+   * Processes next chunk of text, calls on_match(offset)
+   * for every occurrence of pattern ending in this chunk.
+   */
+  template <typename Iterator, typename Function>
+  void feed(Iterator begin, Iterator end, Function on_match) {
+    const uint32* transitions = transitions_.data();
+    uint32 state = state_;
+    uint64 position = position_;
+    for (; begin != end; ++begin) {
+      const uint64 letter = std::min(index(*begin), uint64(alphabet_size_));
+      state = transitions[state + uint32(letter)];
+      position++;
+      if (state == final_)
+        on_match(position - size_);
+    }
+    state_ = state;
+    position_ = position;
+  }
+
+  /**
+   * Processes next chunk of text, appends offsets of occurrences to matches.
+   */
+  template <typename Iterator>
+  void feed(Iterator begin, Iterator end, std::vector<uint64>& matches) {
+    feed(begin, end, [&matches](uint64 offset) { matches.push_back(offset); });
+  }
+
+  /**
+   * Returns number of elements processed so far.
+   */
+  uint64 position() const {
+    return position_;
+  }
+
+  /**
+   * Forgets processed text.
+   */
+  void reset() {
+    state_ = 0;
+    position_ = 0;
+  }
+
+private:
+  /**
+   * Returns position of value in alphabet, values outside of alphabet
+   * are mapped to at least alphabet_size_.
+   */
+  template <typename Value>
+  uint64 index(const Value& value) const {
+    return uint64(int64(value) - alphabet_first_);
+  }
+
+  std::vector<uint32> transitions_;
+  int64 alphabet_first_;
+  uint32 alphabet_size_;
+  uint32 final_;
+  uint32 size_;
+  uint32 state_;
+  uint64 position_;
+};
+
 } // namespace lib
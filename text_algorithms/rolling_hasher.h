@@ -0,0 +1,301 @@
+#pragma once
+// Jakub Staroń, 2016
+
+#include "text_algorithms/hasher.h"
+
+namespace lib {
+
+namespace detail {
+
+/**
+ * Returns Backend::base()^exponent.
+ */
+template <typename Backend>
+typename Backend::hash_type PowerOfBase(size_t exponent) {
+  typename Backend::hash_type result = Backend::one(), power = Backend::base();
+  for (; exponent > 0; exponent /= 2) {
+    if (exponent % 2 == 1)
+      result = Backend::multiply(result, power);
+    power = Backend::multiply(power, power);
+  }
+  return result;
+}
+
+/**
+ * Constants and step of hash of sliding window of fixed length.
+ *
+ * Each step costs two independent multiplications, but only one of
+ * them depends on previous hash.
+ */
+template <typename Backend, typename Mode>
+class RollingWindow {
+public:
+  using hash_type = typename Backend::hash_type;
+  using scalar_type = hash::scalar_type;
+
+  explicit RollingWindow(size_t window) {
+    init(window, Mode());
+  }
+
+  /**
+   * Returns hash of window [begin, begin + window).
+   */
+  template <typename Iterator>
+  hash_type first(Iterator begin, size_t window) const {
+    hash_type result = Backend::zero(), power = Backend::one();
+    for (size_t i = 0; i < window; ++i, ++begin)
+      result = append(result, power, scalar_type(*begin));
+    return result;
+  }
+
+  /**
+   * Returns hash of not full window extended by value.
+   * Power is base^size of window and it's multiplied by base.
+   */
+  hash_type append(const hash_type& hash, hash_type& power, scalar_type value) const {
+    return append(hash, power, value, Mode());
+  }
+
+  /**
+   * Returns hash of window moved by one element, ie without out and with in.
+   */
+  hash_type roll(const hash_type& hash, scalar_type in, scalar_type out) const {
+    return roll(hash, in, out, Mode());
+  }
+
+private:
+  void init(size_t window, hash::compatible) {
+    inverse_base_ = Backend::inverse(Backend::base());
+    top_power_ = PowerOfBase<Backend>(window - 1);
+  }
+
+  void init(size_t window, hash::inverse_free) {
+    top_power_ = PowerOfBase<Backend>(window);
+  }
+
+  hash_type append(const hash_type& hash, hash_type& power, scalar_type value, hash::compatible) const {
+    hash_type result = Backend::add(hash, Backend::multiply(power, value));
+    power = Backend::multiply(power, Backend::base());
+    return result;
+  }
+
+  hash_type append(const hash_type& hash, hash_type&, scalar_type value, hash::inverse_free) const {
+    return Backend::add(Backend::multiply(hash, Backend::base()), Backend::scalar(value));
+  }
+
+  hash_type roll(const hash_type& hash, scalar_type in, scalar_type out, hash::compatible) const {
+    // (h - out) / base + in * base^(window - 1)
+    hash_type shifted = Backend::multiply(Backend::subtract(hash, Backend::scalar(out)), inverse_base_);
+    return Backend::add(shifted, Backend::multiply(top_power_, in));
+  }
+
+  hash_type roll(const hash_type& hash, scalar_type in, scalar_type out, hash::inverse_free) const {
+    // h * base + in - out * base^window
+    hash_type shifted = Backend::add(Backend::multiply(hash, Backend::base()), Backend::scalar(in));
+    return Backend::subtract(shifted, Backend::multiply(top_power_, out));
+  }
+
+  hash_type inverse_base_;
+  hash_type top_power_;
+};
+
+constexpr size_t kRollingLanes = 4;
+
+template <typename Backend, typename Mode, typename Iterator>
+size_t HashWindows(Iterator begin, size_t count, size_t window,
+                   typename Backend::hash_type* output, std::forward_iterator_tag) {
+  using scalar_type = hash::scalar_type;
+  const RollingWindow<Backend, Mode> rolling(window);
+  auto hash = rolling.first(begin, window);
+  Iterator in = std::next(begin, window);
+  for (size_t i = 0; i < count; i++, ++begin) {
+    output[i] = hash;
+    if (i + 1 < count)
+      hash = rolling.roll(hash, scalar_type(*in++), scalar_type(*begin));
+  }
+  return count;
+}
+
+/**
+ * Windows are split between kRollingLanes independent chains of rolling hashes,
+ * each one starting with its own first window.
+ */
+template <typename Backend, typename Mode, typename Iterator>
+size_t HashWindows(Iterator begin, size_t count, size_t window,
+                   typename Backend::hash_type* output, std::random_access_iterator_tag) {
+  using hash_type = typename Backend::hash_type;
+  using scalar_type = hash::scalar_type;
+  if (count < kRollingLanes * window)
+    return HashWindows<Backend, Mode>(begin, count, window, output, std::forward_iterator_tag());
+
+  const RollingWindow<Backend, Mode> rolling(window);
+  const size_t segment = count / kRollingLanes;
+  hash_type hashes[kRollingLanes];
+  for (size_t lane = 0; lane < kRollingLanes; lane++)
+    hashes[lane] = rolling.first(begin + lane * segment, window);
+
+  for (size_t i = 0; i + 1 < segment; i++) {
+    for (size_t lane = 0; lane < kRollingLanes; lane++) {
+      const size_t position = lane * segment + i;
+      output[position] = hashes[lane];
+      hashes[lane] = rolling.roll(hashes[lane], scalar_type(begin[position + window]), scalar_type(begin[position]));
+    }
+  }
+  for (size_t lane = 0; lane + 1 < kRollingLanes; lane++)
+    output[(lane + 1) * segment - 1] = hashes[lane];
+
+  // last lane takes also remaining windows
+  hash_type hash = hashes[kRollingLanes - 1];
+  for (size_t position = kRollingLanes * segment - 1; position < count; position++) {
+    output[position] = hash;
+    if (position + 1 < count)
+      hash = rolling.roll(hash, scalar_type(begin[position + window]), scalar_type(begin[position]));
+  }
+  return count;
+}
+
+} // namespace detail
+
+/**
+ * Hash of the last window elements of a stream.
+ *
+ * Elements are pushed one by one and only the last window of them
+ * are kept, so memory is O(window) no matter how long the stream is.
+ * Each push takes constant time.
+ *
+ * Hashes use arithmetic of Backend, so they can be compared with
+ * hashes computed by BasicHasher<Backend, Mode> and hash::hash:
+ * - hash::compatible (default) - getHash() is equal to
+ *   hash::hash<Backend> of the window,
+ * - hash::inverse_free - getHash() is equal to hash::hash<Backend>
+ *   of reversed window, no inverse of base is computed.
+ *
+ * Until window elements are pushed getHash() returns hash of all of them.
+ *
+ * Example:
+ * <pre>
+ * RollingHasher hasher(3);
+ * for (char c: std::string("abcab"))
+ *   hasher.push(c);
+ * hasher.getHash() == hash::hash("cab");
+ * </pre>
+ */
+template <typename Backend, typename Mode = hash::compatible>
+class BasicRollingHasher {
+public:
+  using backend_type = Backend;
+  using mode_type = Mode;
+  using hash_type = typename Backend::hash_type;
+  using scalar_type = hash::scalar_type;
+
+  /**
+   * Throws an std::invalid_argument if window is 0.
+   */
+  explicit BasicRollingHasher(size_t window):
+      rolling_(CheckWindow(window)),
+      buffer_(window),
+      position_(0),
+      size_(0),
+      hash_(Backend::zero()),
+      power_(Backend::one()) { }
+
+  /**
+   * Appends value to stream, removes the oldest element if window is full.
+   */
+  void push(scalar_type value) {
+    if (full()) {
+      hash_ = rolling_.roll(hash_, value, buffer_[position_]);
+    }
+    else {
+      hash_ = rolling_.append(hash_, power_, value);
+      size_++;
+    }
+    buffer_[position_] = value;
+    if (++position_ == buffer_.size())
+      position_ = 0;
+  }
+
+  /**
+   * Pushes all elements of range.
+   */
+  template <typename Iterator>
+  void push(Iterator begin, Iterator end) {
+    for (; begin != end; ++begin)
+      push(scalar_type(*begin));
+  }
+
+  /**
+   * Returns hash of the last min(size(), window()) elements.
+   */
+  hash_type getHash() const {
+    return hash_;
+  }
+
+  /**
+   * Returns number of elements in window.
+   */
+  size_t size() const {
+    return size_;
+  }
+
+  size_t window() const {
+    return buffer_.size();
+  }
+
+  bool full() const {
+    return size_ == buffer_.size();
+  }
+
+  /**
+   * Removes all elements.
+   */
+  void clear() {
+    position_ = 0;
+    size_ = 0;
+    hash_ = Backend::zero();
+    power_ = Backend::one();
+  }
+
+private:
+  static size_t CheckWindow(size_t window) {
+    if (window == 0)
+      throw std::invalid_argument("BasicRollingHasher - window must be positive");
+    return window;
+  }
+
+  detail::RollingWindow<Backend, Mode> rolling_;
+  std::vector<scalar_type> buffer_;
+  size_t position_;
+  size_t size_;
+  hash_type hash_;
+  hash_type power_; // base^size() while window is not full
+};
+
+using RollingHasher = BasicRollingHasher<hash::prime_pair>;
+
+/**
+ * Writes hashes of all windows of given length of sequence to output,
+ * ie output[i] is hash of [begin + i, begin + i + window).
+ * Hashes are the same as returned by BasicRollingHasher<Backend, Mode>.
+ *
+ * Output must have place for max(0, length - window + 1) hashes,
+ * returns their number.
+ *
+ * For random access iterators consecutive windows are hashed
+ * by several independent chains, which is a few times faster
+ * than pushing elements to BasicRollingHasher.
+ *
+ * Throws an std::invalid_argument if window is 0.
+ */
+template <typename Backend = hash::prime_pair, typename Mode = hash::compatible, typename Iterator>
+size_t HashWindows(Iterator begin, Iterator end, size_t window, typename Backend::hash_type* output) {
+  if (window == 0)
+    throw std::invalid_argument("HashWindows - window must be positive");
+  const size_t length = size_t(std::distance(begin, end));
+  if (length < window)
+    return 0;
+  return detail::HashWindows<Backend, Mode>(begin, length - window + 1, window, output,
+      typename std::iterator_traits<Iterator>::iterator_category());
+}
+
+} // namespace lib
@@ -0,0 +1,299 @@
+#pragma once
+// Jakub Staroń, 2016
+
+#include "headers.h"
+#include "data_structures/range_minimum_query.h"
+
+namespace lib {
+
+namespace detail {
+
+constexpr uint32 kNoSuffix = std::numeric_limits<uint32>::max();
+
+/**
+ * Sorts suffixes with induced sorting (SA-IS), letters of text are in [0, alphabet_size).
+ *
+ * Types of suffixes (S or L) are kept in bit vector and buckets take
+ * O(alphabet_size). Reduced problem of LMS substrings has at most n/2 letters,
+ * it's stored in the second half of suffix_array and solved recursively
+ * in the first half, so for bytes only n/8 bytes are used besides suffix_array
+ * (recursion needs buckets for alphabet of reduced problem).
+ */
+template <typename Letter>
+void InducedSort(const Letter* text, uint32 n, uint32 alphabet_size, uint32* suffix_array) {
+  if (n == 0)
+    return;
+  if (n == 1) {
+    suffix_array[0] = 0;
+    return;
+  }
+
+  // smaller[i] iff suffix i is S-type, ie smaller than suffix i + 1
+  std::vector<bool> smaller(n, false);
+  for (uint32 i = n - 1; i-- > 0;)
+    smaller[i] = text[i] == text[i + 1]? smaller[i + 1] : text[i] < text[i + 1];
+  auto is_lms = [&smaller](uint32 i) {
+    return i > 0 && i != kNoSuffix && !smaller[i - 1] && smaller[i];
+  };
+
+  std::vector<uint32> counts(alphabet_size + 1, 0), bucket(alphabet_size + 1);
+  for (uint32 i = 0; i < n; i++)
+    counts[text[i] + 1]++;
+  std::partial_sum(counts.begin(), counts.end(), counts.begin());
+  auto bucket_begins = [&]() {
+    std::copy(counts.begin(), counts.end() - 1, bucket.begin());
+  };
+  auto bucket_ends = [&]() {
+    std::copy(counts.begin() + 1, counts.end(), bucket.begin());
+  };
+
+  // order of all suffixes is induced from LMS suffixes put at the ends of buckets
+  auto induce = [&]() {
+    bucket_begins();
+    suffix_array[bucket[text[n - 1]]++] = n - 1;
+    for (uint32 i = 0; i < n; i++) {
+      const uint32 v = suffix_array[i];
+      if (v != kNoSuffix && v >= 1 && !smaller[v - 1])
+        suffix_array[bucket[text[v - 1]]++] = v - 1;
+    }
+    bucket_ends();
+    for (uint32 i = n; i-- > 0;) {
+      const uint32 v = suffix_array[i];
+      if (v != kNoSuffix && v >= 1 && smaller[v - 1])
+        suffix_array[--bucket[text[v - 1]]] = v - 1;
+    }
+  };
+
+  // LMS suffixes in text order are sorted by their LMS substrings
+  std::fill(suffix_array, suffix_array + n, kNoSuffix);
+  bucket_ends();
+  uint32 m = 0;
+  for (uint32 i = 1; i < n; i++) {
+    if (is_lms(i)) {
+      suffix_array[--bucket[text[i]]] = i;
+      m++;
+    }
+  }
+  induce();
+  if (m == 0)
+    return;
+
+  uint32 sorted = 0;
+  for (uint32 i = 0; i < n; i++)
+    if (is_lms(suffix_array[i]))
+      suffix_array[sorted++] = suffix_array[i];
+
+  // names of LMS substrings are stored at m + position / 2 (LMS positions differ at least by 2)
+  std::fill(suffix_array + m, suffix_array + n, kNoSuffix);
+  uint32 name = 0;
+  for (uint32 i = 0; i < m; i++) {
+    if (i > 0) {
+      const uint32 l = suffix_array[i - 1], r = suffix_array[i];
+      bool same = true;
+      // compare LMS substrings letter by letter up to the next LMS position
+      for (uint32 k = 0;; k++) {
+        if (l + k == n || r + k == n || text[l + k] != text[r + k] || smaller[l + k] != smaller[r + k]) {
+          same = false;
+          break;
+        }
+        if (k > 0 && (is_lms(l + k) || is_lms(r + k))) {
+          same = is_lms(l + k) && is_lms(r + k);
+          break;
+        }
+      }
+      if (!same)
+        name++;
+    }
+    suffix_array[m + suffix_array[i] / 2] = name;
+  }
+
+  // reduced text (names in text order) is moved to the end of suffix_array
+  uint32* reduced = suffix_array + n - m;
+  for (uint32 i = n, j = n; i-- > m;)
+    if (suffix_array[i] != kNoSuffix)
+      suffix_array[--j] = suffix_array[i];
+
+  if (name + 1 < m) {
+    InducedSort(reduced, m, name + 1, suffix_array);
+  }
+  else {
+    // names are distinct, so they are ranks of LMS suffixes
+    for (uint32 i = 0; i < m; i++)
+      suffix_array[reduced[i]] = i;
+  }
+
+  // suffix array of reduced text -> sorted LMS positions
+  for (uint32 i = 1, j = 0; i < n; i++)
+    if (is_lms(i))
+      reduced[j++] = i;
+  for (uint32 i = 0; i < m; i++)
+    suffix_array[i] = reduced[suffix_array[i]];
+
+  // sorted LMS suffixes are moved from suffix_array[0, m) to the ends of buckets,
+  // from the greatest one, so none of them is overwritten before it's moved
+  std::fill(suffix_array + m, suffix_array + n, kNoSuffix);
+  bucket_ends();
+  for (uint32 i = m; i-- > 0;) {
+    const uint32 position = suffix_array[i];
+    suffix_array[i] = kNoSuffix;
+    suffix_array[--bucket[text[position]]] = position;
+  }
+  induce();
+}
+
+/**
+ * Permutes values indexed by text position to order of suffix array.
+ * Copy of values is kept in words of type Word.
+ */
+template <typename Word>
+void PermuteToSuffixOrder(std::vector<uint32>& values, const std::vector<uint32>& suffix_array) {
+  std::vector<Word> copy(values.begin(), values.end());
+  for (uint32 i = 0; i < values.size(); i++)
+    values[i] = copy[suffix_array[i]];
+}
+
+} // namespace detail
+
+/**
+ * Returns suffix array of sequence of bytes (elements are converted to unsigned char),
+ * ie starting positions of suffixes in lexicographical order.
+ *
+ * Uses SA-IS algorithm, works in O(length) time.
+ */
+template <typename Iterator>
+std::vector<uint32> BuildSuffixArray(Iterator begin, Iterator end) {
+  std::vector<uint8> text;
+  text.reserve(std::distance(begin, end));
+  for (; begin != end; ++begin)
+    text.push_back(uint8(*begin));
+  std::vector<uint32> suffix_array(text.size());
+  detail::InducedSort(text.data(), uint32(text.size()), 256, suffix_array.data());
+  return suffix_array;
+}
+
+/**
+ * Returns suffix array of string without copying it.
+ */
+inline std::vector<uint32> BuildSuffixArray(const std::string& text) {
+  std::vector<uint32> suffix_array(text.size());
+  detail::InducedSort(reinterpret_cast<const uint8*>(text.data()), uint32(text.size()), 256, suffix_array.data());
+  return suffix_array;
+}
+
+/**
+ * Returns suffix array of sequence of integers from [0, alphabet_size).
+ *
+ * Throws an std::invalid_argument if some letter is out of alphabet.
+ */
+inline std::vector<uint32> BuildSuffixArray(const std::vector<uint32>& text, uint32 alphabet_size) {
+  for (uint32 letter: text)
+    if (letter >= alphabet_size)
+      throw std::invalid_argument("BuildSuffixArray - letter out of alphabet");
+  std::vector<uint32> suffix_array(text.size());
+  detail::InducedSort(text.data(), uint32(text.size()), alphabet_size, suffix_array.data());
+  return suffix_array;
+}
+
+/**
+ * Returns LCP array, ie lcp[i] is length of longest common prefix
+ * of suffixes suffix_array[i - 1] and suffix_array[i] (lcp[0] = 0).
+ *
+ * Uses Kasai algorithm in form of permuted LCP: values are computed in order
+ * of text positions in result and then permuted to order of suffix array
+ * through a copy of 1, 2 or 4 bytes per letter, depending on the longest
+ * common prefix. For byte texts without long repeats whole memory
+ * is about 10 bytes per letter (text, suffix array, result and copy).
+ */
+template <typename Iterator>
+std::vector<uint32> BuildLcpArray(Iterator begin, Iterator end, const std::vector<uint32>& suffix_array) {
+  const uint32 n = uint32(suffix_array.size());
+  if (uint32(std::distance(begin, end)) != n)
+    throw std::invalid_argument("BuildLcpArray - suffix array of different sequence");
+  std::vector<uint32> lcp(n);
+  if (n == 0)
+    return lcp;
+
+  // lcp[i] = previous suffix of suffix i in suffix array
+  lcp[suffix_array[0]] = detail::kNoSuffix;
+  for (uint32 i = 1; i < n; i++)
+    lcp[suffix_array[i]] = suffix_array[i - 1];
+
+  // lcp of suffix i and its previous is at least lcp of i - 1 minus one
+  uint32 length = 0;
+  for (uint32 i = 0; i < n; i++) {
+    const uint32 previous = lcp[i];
+    if (previous == detail::kNoSuffix) {
+      lcp[i] = length = 0;
+      continue;
+    }
+    while (i + length < n && previous + length < n && begin[i + length] == begin[previous + length])
+      length++;
+    lcp[i] = length;
+    if (length > 0)
+      length--;
+  }
+
+  // lcp[suffix_array[i]] -> lcp[i], through the narrowest copy which can hold all values
+  const uint32 longest = *std::max_element(lcp.begin(), lcp.end());
+  if (longest <= std::numeric_limits<uint8>::max())
+    detail::PermuteToSuffixOrder<uint8>(lcp, suffix_array);
+  else if (longest <= std::numeric_limits<uint16>::max())
+    detail::PermuteToSuffixOrder<uint16>(lcp, suffix_array);
+  else
+    detail::PermuteToSuffixOrder<uint32>(lcp, suffix_array);
+  return lcp;
+}
+
+/**
+ * Longest common prefix of any two suffixes in constant time.
+ *
+ * Keeps ranks of suffixes and RangeMinimumQuery over LCP array,
+ * which takes O(n log n) memory.
+ *
+ * Example:
+ * <pre>
+ * auto suffix_array = BuildSuffixArray(text);
+ * LongestCommonPrefixQuery query(suffix_array, BuildLcpArray(text.begin(), text.end(), suffix_array));
+ * query.longestCommonPrefix(2, 5);
+ * </pre>
+ */
+class LongestCommonPrefixQuery {
+public:
+  LongestCommonPrefixQuery(const std::vector<uint32>& suffix_array, const std::vector<uint32>& lcp):
+      rank_(suffix_array.size()),
+      rmq_(lcp.begin(), lcp.end()) {
+    if (lcp.size() != suffix_array.size())
+      throw std::invalid_argument("LongestCommonPrefixQuery - arrays of different sizes");
+    for (uint32 i = 0; i < suffix_array.size(); i++)
+      rank_[suffix_array[i]] = i;
+  }
+
+  /**
+   * Returns length of longest common prefix of suffixes starting at first and second.
+   *
+   * Throws an std::out_of_range if position is out of sequence.
+   */
+  uint32 longestCommonPrefix(uint32 first, uint32 second) const {
+    if (first >= rank_.size() || second >= rank_.size())
+      throw std::out_of_range("LongestCommonPrefixQuery - position out of sequence");
+    if (first == second)
+      return uint32(rank_.size()) - first;
+    uint32 lower = rank_[first], upper = rank_[second];
+    if (lower > upper)
+      std::swap(lower, upper);
+    return rmq_.value(rmq_.minimum(lower + 1, upper));
+  }
+
+  /**
+   * Returns position of suffix in suffix array.
+   */
+  uint32 rank(uint32 position) const {
+    return rank_[position];
+  }
+
+private:
+  std::vector<uint32> rank_;
+  RangeMinimumQuery<uint32> rmq_;
+};
+
+} // namespace lib
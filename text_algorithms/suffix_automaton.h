@@ -0,0 +1,381 @@
+#pragma once
+// Jakub Staroń, 2016
+
+#include "headers.h"
+
+namespace lib {
+
+/**
+ * Suffix automaton (DAWG) of a sequence of bytes (elements are converted
+ * to unsigned char), built online: letters are pushed one by one
+ * and queries can be asked at any moment.
+ *
+ * Automaton of n letters has at most 2n states and 3n transitions.
+ * States are kept in one flat array (16 bytes each) and transitions
+ * of every state in a block of one pool of edges, sorted by letters,
+ * so lookup scans at most a few bytes (or binary searches for large
+ * degree). Blocks have capacities of powers of two, a full block
+ * is moved to a twice larger one and freed blocks are reused.
+ * The only transition of state of degree 1 is kept in the state
+ * and transitions of root in a table.
+ *
+ * For random texts of 10^7 letters over 4 or 26 letters it allocates
+ * about 50 bytes per letter at peak (including copies made when vectors
+ * grow), instead of over 210 with std::map in every state.
+ *
+ * Example:
+ * <pre>
+ * SuffixAutomaton automaton(text.begin(), text.end());
+ * automaton.distinctSubstrings();
+ * automaton.occurrences(pattern.begin(), pattern.end());
+ * automaton.push('a');
+ * </pre>
+ */
+class SuffixAutomaton {
+public:
+  /**
+   * Builds automaton of empty sequence.
+   */
+  SuffixAutomaton():
+      last_(0),
+      size_(0),
+      root_edges_(0),
+      distinct_(0),
+      edges_(0),
+      counted_(0) {
+    std::fill(std::begin(root_), std::end(root_), uint32(kNone));
+    newState(0, false);
+  }
+
+  template <typename Iterator>
+  SuffixAutomaton(Iterator begin, Iterator end):
+      SuffixAutomaton() {
+    push(begin, end);
+  }
+
+  /**
+   * Appends letter to sequence in amortized O(alphabet size) time.
+   *
+   * Throws an std::length_error if sequence has 2^28 - 1 letters.
+   */
+  void push(uint8 letter) {
+    if (size_ == kMaxSize)
+      throw std::length_error("SuffixAutomaton - too many letters");
+    const uint32 current = newState(states_[last_].length + 1, false);
+    uint32 state = last_;
+    uint32 target = kNone;
+    for (; state != kNone; state = states_[state].link) {
+      target = next(state, letter);
+      if (target != kNone)
+        break;
+      addEdge(state, letter, current);
+    }
+
+    if (state == kNone) {
+      states_[current].link = 0;
+    }
+    else if (states_[state].length + 1 == states_[target].length) {
+      states_[current].link = target;
+    }
+    else {
+      const uint32 clone = newState(states_[state].length + 1, true);
+      copyEdges(target, clone);
+      states_[clone].link = states_[target].link;
+      for (; state != kNone; state = states_[state].link) {
+        uint32* transition = find(state, letter);
+        if (*transition != target)
+          break;
+        *transition = clone;
+      }
+      states_[target].link = states_[current].link = clone;
+    }
+    last_ = current;
+    size_++;
+    distinct_ += states_[current].length - states_[states_[current].link].length;
+  }
+
+  /**
+   * Appends all elements of range.
+   */
+  template <typename Iterator>
+  void push(Iterator begin, Iterator end) {
+    for (; begin != end; ++begin)
+      push(uint8(*begin));
+  }
+
+  /**
+   * Returns number of letters of sequence.
+   */
+  uint32 size() const {
+    return size_;
+  }
+
+  uint32 states() const {
+    return uint32(states_.size());
+  }
+
+  uint32 edges() const {
+    return edges_ + root_edges_;
+  }
+
+  /**
+   * Returns number of distinct non-empty substrings, it's updated by every push.
+   */
+  uint64 distinctSubstrings() const {
+    return distinct_;
+  }
+
+  /**
+   * Returns true if pattern is a substring of sequence.
+   */
+  template <typename Iterator>
+  bool contains(Iterator begin, Iterator end) const {
+    return walk(begin, end) != kNone;
+  }
+
+  /**
+   * Returns number of occurrences of pattern in sequence, empty pattern
+   * occurs size() + 1 times.
+   *
+   * Numbers of occurrences of all states are computed in O(states())
+   * by the first call after push and kept until the next push.
+   */
+  template <typename Iterator>
+  uint64 occurrences(Iterator begin, Iterator end) const {
+    const uint32 state = walk(begin, end);
+    if (state == kNone)
+      return 0;
+    if (state == 0)
+      return uint64(size_) + 1;
+    if (counts_.empty() || counted_ != size_)
+      countOccurrences();
+    return counts_[state];
+  }
+
+  /**
+   * Returns longest common substring of sequence and other sequence
+   * as pair of its offset in other sequence and its length,
+   * in O(length of other sequence) time.
+   */
+  template <typename Iterator>
+  std::pair<uint64, uint32> longestCommonSubstring(Iterator begin, Iterator end) const {
+    std::pair<uint64, uint32> result(0, 0);
+    uint32 state = 0, length = 0;
+    for (uint64 position = 1; begin != end; ++begin, ++position) {
+      const uint8 letter = uint8(*begin);
+      while (state != 0 && next(state, letter) == kNone) {
+        state = states_[state].link;
+        length = states_[state].length;
+      }
+      const uint32 target = next(state, letter);
+      if (target != kNone) {
+        state = target;
+        length++;
+      }
+      if (length > result.second)
+        result = std::make_pair(position - length, length);
+    }
+    return result;
+  }
+
+  /**
+   * Returns memory used by automaton in bytes.
+   */
+  size_t bytes() const {
+    size_t result = sizeof(root_) + states_.capacity() * sizeof(State) + letters_.capacity() * sizeof(uint8) +
+        targets_.capacity() * sizeof(uint32) + counts_.capacity() * sizeof(uint32);
+    for (const auto& free_blocks: free_blocks_)
+      result += free_blocks.capacity() * sizeof(uint32);
+    return result;
+  }
+
+private:
+  static constexpr uint32 kNone = std::numeric_limits<uint32>::max();
+  // block of state of final degree d takes at most 2d edges and blocks
+  // it outgrew less than 2d, there are at most 3n edges, so pool of edges
+  // has less than 12n entries and indices of it fit in uint32
+  static constexpr uint32 kMaxSize = (1u << 28) - 1;
+
+  static constexpr uint32 kLinearSearchDegree = 8;
+  static constexpr uint32 kSizeClasses = 9;
+
+  struct State {
+    uint32 length;
+    uint32 link;
+    uint32 edges; // target of the only edge if degree is 1, otherwise first edge of block
+    uint16 degree;
+    uint8 letter; // letter of the only edge
+    bool clone;
+  };
+
+  uint32 newState(uint32 length, bool clone) {
+    states_.push_back(State{length, kNone, 0, 0, 0, clone});
+    return uint32(states_.size() - 1);
+  }
+
+  /**
+   * Returns size class of block for degree, ie log2 of its capacity.
+   */
+  static uint32 SizeClass(uint32 degree) {
+    uint32 size_class = 0;
+    while ((uint32(1) << size_class) < degree)
+      size_class++;
+    return size_class;
+  }
+
+  /**
+   * Returns block of 2^size_class edges, freed one or from the end of pool.
+   */
+  uint32 allocateBlock(uint32 size_class) {
+    auto& free_blocks = free_blocks_[size_class];
+    if (!free_blocks.empty()) {
+      const uint32 block = free_blocks.back();
+      free_blocks.pop_back();
+      return block;
+    }
+    const uint32 block = uint32(letters_.size());
+    letters_.resize(block + (size_t(1) << size_class));
+    targets_.resize(letters_.size());
+    return block;
+  }
+
+  /**
+   * Adds transition to state, moves its edges to block twice as large if it's full.
+   */
+  void addEdge(uint32 state, uint8 letter, uint32 target) {
+    if (state == 0) {
+      root_[letter] = target;
+      root_edges_++;
+      return;
+    }
+    edges_++;
+    State& from = states_[state];
+    if (from.degree == 0) {
+      from.edges = target;
+      from.letter = letter;
+      from.degree = 1;
+      return;
+    }
+    if (from.degree == 1) {
+      const uint32 block = allocateBlock(1);
+      letters_[block] = from.letter;
+      targets_[block] = from.edges;
+      from.edges = block;
+    }
+    else if ((from.degree & (from.degree - 1)) == 0) {
+      const uint32 size_class = SizeClass(from.degree);
+      const uint32 block = allocateBlock(size_class + 1);
+      std::copy_n(letters_.begin() + from.edges, from.degree, letters_.begin() + block);
+      std::copy_n(targets_.begin() + from.edges, from.degree, targets_.begin() + block);
+      free_blocks_[size_class].push_back(from.edges);
+      from.edges = block;
+    }
+    uint32 i = from.edges + from.degree;
+    for (; i > from.edges && letters_[i - 1] > letter; i--) {
+      letters_[i] = letters_[i - 1];
+      targets_[i] = targets_[i - 1];
+    }
+    letters_[i] = letter;
+    targets_[i] = target;
+    from.degree++;
+  }
+
+  /**
+   * Copies edges of state to clone.
+   */
+  void copyEdges(uint32 state, uint32 clone) {
+    const uint32 degree = states_[state].degree;
+    edges_ += degree;
+    if (degree <= 1) {
+      states_[clone].edges = states_[state].edges;
+      states_[clone].letter = states_[state].letter;
+      states_[clone].degree = uint16(degree);
+      return;
+    }
+    const uint32 block = allocateBlock(SizeClass(degree));
+    std::copy_n(letters_.begin() + states_[state].edges, degree, letters_.begin() + block);
+    std::copy_n(targets_.begin() + states_[state].edges, degree, targets_.begin() + block);
+    states_[clone].edges = block;
+    states_[clone].degree = uint16(degree);
+  }
+
+  /**
+   * Returns pointer to transition of state by letter or nullptr.
+   */
+  const uint32* transition(uint32 state, uint8 letter) const {
+    if (state == 0)
+      return root_[letter] != kNone? &root_[letter] : nullptr;
+    const State& from = states_[state];
+    if (from.degree <= 1)
+      return from.degree == 1 && from.letter == letter? &from.edges : nullptr;
+    const uint8* begin = letters_.data() + from.edges;
+    const uint8* end = begin + from.degree;
+    const uint8* it = begin;
+    if (from.degree <= kLinearSearchDegree) {
+      while (it != end && *it < letter)
+        ++it;
+    }
+    else {
+      it = std::lower_bound(begin, end, letter);
+    }
+    return it != end && *it == letter? &targets_[it - letters_.data()] : nullptr;
+  }
+
+  /**
+   * Returns transition of state by letter or kNone.
+   */
+  uint32 next(uint32 state, uint8 letter) const {
+    const uint32* target = transition(state, letter);
+    return target != nullptr? *target : kNone;
+  }
+
+  uint32* find(uint32 state, uint8 letter) {
+    return const_cast<uint32*>(transition(state, letter));
+  }
+
+  template <typename Iterator>
+  uint32 walk(Iterator begin, Iterator end) const {
+    uint32 state = 0;
+    for (; begin != end && state != kNone; ++begin)
+      state = next(state, uint8(*begin));
+    return state;
+  }
+
+  /**
+   * Number of occurrences of state is number of states which are not clones
+   * in its subtree of suffix links, they are summed from the longest states.
+   */
+  void countOccurrences() const {
+    const uint32 states = this->states();
+    std::vector<uint32> order(states), starts(size_ + 2, 0);
+    for (uint32 state = 0; state < states; state++)
+      starts[states_[state].length + 1]++;
+    std::partial_sum(starts.begin(), starts.end(), starts.begin());
+    for (uint32 state = 0; state < states; state++)
+      order[starts[states_[state].length]++] = state;
+
+    counts_.assign(states, 0);
+    for (uint32 state = 1; state < states; state++)
+      counts_[state] = states_[state].clone? 0 : 1;
+    for (uint32 i = states; i-- > 1;)
+      counts_[states_[order[i]].link] += counts_[order[i]];
+    counted_ = size_;
+  }
+
+  uint32 root_[256];
+  uint32 last_;
+  uint32 size_;
+  uint32 root_edges_;
+  uint64 distinct_;
+  uint32 edges_;
+  std::vector<State> states_;
+  // edges of every state are in block of pool, sorted by letters
+  std::vector<uint8> letters_;
+  std::vector<uint32> targets_;
+  std::vector<uint32> free_blocks_[kSizeClasses];
+  // numbers of occurrences of states for sequence of counted_ letters
+  mutable std::vector<uint32> counts_;
+  mutable uint32 counted_;
+};
+
+} // namespace lib